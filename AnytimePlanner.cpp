@@ -0,0 +1,247 @@
+// AnytimePlanner.cpp
+#include "AnytimePlanner.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cmath>
+
+using namespace std;
+
+AnytimePlanner::AnytimePlanner(const Map* map)
+    : map(map), trapCost(1), maxTraps(-1), trapLimit(-1), initialEpsilon(3 * EPSILON_SCALE), epsilonStep(EPSILON_SCALE / 2),
+      cancelled(false), expandedCount(0), cellCount(0), goalCell(-1), goalState(-1), epsilon(EPSILON_SCALE),
+      pathCost(0) {}
+
+void AnytimePlanner::setTrapCost(int cost) {
+    trapCost = max(1, min(cost, 1000));
+}
+
+void AnytimePlanner::setInflation(double initial, double step) {
+    initialEpsilon = max(EPSILON_SCALE, static_cast<int>(lround(initial * EPSILON_SCALE)));
+    epsilonStep = max(1, static_cast<int>(lround(step * EPSILON_SCALE)));
+}
+
+bool AnytimePlanner::plan(const Position& start, const Position& goal, const SolutionCallback& onSolution,
+                          const atomic<bool>* cancel) {
+    cancelled = false;
+    expandedCount = 0;
+
+    if (map->getCell(start.x, start.y) == WALL || map->getCell(goal.x, goal.y) == WALL ||
+        !map->isReachable(start, goal)) {
+        return false;
+    }
+
+    // 状态下标 = 已踩陷阱数 * 格子数 + 格子下标，与带权搜索相同（层数同样受上限约束）
+    cellCount = map->getCellCount();
+    int layers = maxTraps >= 0 ? SearchContext::clampLayers(cellCount, maxTraps + 1) : 1;
+    trapLimit = maxTraps >= 0 ? layers - 1 : -1;
+    int stateCount = cellCount * layers;
+    context.prepare(stateCount);
+    if (static_cast<int>(flags.size()) != stateCount) {
+        flags.assign(stateCount, 0);
+    }
+    open.clear();
+    incons.clear();
+    closed.clear();
+
+    goalCell = map->cellIndex(goal.x, goal.y);
+    goalState = -1;
+    epsilon = initialEpsilon;
+
+    int startCell = map->cellIndex(start.x, start.y);
+    context.visit(startCell, 0, -1);
+    flags[startCell] = 0;
+    push(startCell);
+
+    // 起点就是终点：终点状态只在松弛邻居时设置，这里直接发布单格路径（与带权搜索一致）
+    if (startCell == goalCell) {
+        goalState = startCell;
+        extractPath();
+        if (onSolution) {
+            onSolution(path, pathCost, 1.0);
+        }
+        return true;
+    }
+
+    bool found = false;
+    int publishedCost = INF;
+    double publishedBound = 0;
+    while (true) {
+        if (!improvePath(cancel)) {
+            cancelled = true;
+            return found;
+        }
+        if (goalState < 0) {
+            return found;  // 在预算内不可达
+        }
+
+        // 次优上界：ε 与 g(goal) / min(g + h) 中较小者
+        int goalG = context.gCost[goalState];
+        double bound = static_cast<double>(epsilon) / EPSILON_SCALE;
+        int lowest = goalG;
+        for (const Entry& entry : open) {
+            if ((flags[entry.state] & FLAG_OPEN) && entry.g == context.gCost[entry.state]) {
+                lowest = min(lowest, entry.g + heuristic(entry.state % cellCount));
+            }
+        }
+        for (int state : incons) {
+            lowest = min(lowest, context.gCost[state] + heuristic(state % cellCount));
+        }
+        if (lowest > 0) {
+            bound = min(bound, static_cast<double>(goalG) / lowest);
+        }
+        bound = max(1.0, bound);
+
+        // 只在路径变好或上界收紧时发布
+        if (goalG < publishedCost || bound < publishedBound) {
+            extractPath();
+            found = true;
+            if (onSolution) {
+                onSolution(path, pathCost, bound);
+            }
+            publishedCost = goalG;
+            publishedBound = bound;
+        }
+
+        if (epsilon <= EPSILON_SCALE || bound <= 1.0) {
+            return true;  // 已是最优
+        }
+        if (cancel && cancel->load(memory_order_relaxed)) {
+            cancelled = true;
+            return true;
+        }
+        epsilon = max(EPSILON_SCALE, epsilon - epsilonStep);
+        reopen();
+    }
+}
+
+int AnytimePlanner::heuristic(int cell) const {
+    Position a = map->indexToPosition(cell);
+    Position b = map->indexToPosition(goalCell);
+    return abs(a.x - b.x) + abs(a.y - b.y);
+}
+
+void AnytimePlanner::push(int state) {
+    Entry entry;
+    entry.state = state;
+    entry.g = context.gCost[state];
+    entry.key = static_cast<int64_t>(entry.g) * EPSILON_SCALE +
+                static_cast<int64_t>(epsilon) * heuristic(state % cellCount);
+    open.push_back(entry);
+    push_heap(open.begin(), open.end(), greater<Entry>());
+    flags[state] |= FLAG_OPEN;
+}
+
+bool AnytimePlanner::improvePath(const atomic<bool>* cancel) {
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+
+    while (!open.empty()) {
+        // 终点的 key 为 g(goal) * EPSILON_SCALE（h = 0）
+        if (goalState >= 0 && open.front().key >= static_cast<int64_t>(context.gCost[goalState]) * EPSILON_SCALE) {
+            break;
+        }
+
+        pop_heap(open.begin(), open.end(), greater<Entry>());
+        Entry current = open.back();
+        open.pop_back();
+        int state = current.state;
+        if (!(flags[state] & FLAG_OPEN) || current.g != context.gCost[state]) {
+            continue;  // 过期条目
+        }
+        flags[state] = static_cast<uint8_t>((flags[state] & ~FLAG_OPEN) | FLAG_CLOSED);
+        closed.push_back(state);
+
+        // 定期检查取消标志，避免每次扩展都读原子变量
+        if ((++expandedCount & 1023) == 0 && cancel && cancel->load(memory_order_relaxed)) {
+            return false;
+        }
+
+        int cell = state % cellCount;
+        int layer = state / cellCount;
+        if (cell == goalCell) {
+            continue;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            int neighbor = cell + offsets[i];
+            uint8_t type = cells[neighbor];
+            if (type == WALL) {
+                continue;
+            }
+
+            int stepCost = 1;
+            int neighborLayer = layer;
+            if (type == TRAP) {
+                stepCost = trapCost;
+                if (trapLimit >= 0) {
+                    if (layer >= trapLimit) {
+                        continue;  // 再踩一个陷阱就会耗尽生命值
+                    }
+                    neighborLayer = layer + 1;
+                }
+            }
+
+            int next = neighborLayer * cellCount + neighbor;
+            int newG = context.gCost[state] + stepCost;
+            if (!context.isVisited(next)) {
+                flags[next] = 0;
+            } else if (newG >= context.gCost[next]) {
+                continue;
+            }
+            context.visit(next, newG, state);
+            if (neighbor == goalCell && (goalState < 0 || newG < context.gCost[goalState])) {
+                goalState = next;
+            }
+
+            if (!(flags[next] & FLAG_CLOSED)) {
+                push(next);
+            } else if (!(flags[next] & FLAG_INCONS)) {
+                // 本轮已扩展过的状态变得更优：留到下一轮再处理
+                flags[next] |= FLAG_INCONS;
+                incons.push_back(next);
+            }
+        }
+    }
+    return true;
+}
+
+void AnytimePlanner::reopen() {
+    // 收集仍在开放列表中的状态（每个状态只保留一份）和不一致状态
+    for (const Entry& entry : open) {
+        if ((flags[entry.state] & FLAG_OPEN) && entry.g == context.gCost[entry.state]) {
+            flags[entry.state] &= ~FLAG_OPEN;
+            incons.push_back(entry.state);
+        }
+    }
+    open.clear();
+
+    for (int state : closed) {
+        flags[state] = 0;
+    }
+    closed.clear();
+    for (int state : incons) {
+        flags[state] = 0;
+    }
+    for (int state : incons) {
+        if (!(flags[state] & FLAG_OPEN)) {
+            push(state);
+        }
+    }
+    incons.clear();
+}
+
+void AnytimePlanner::extractPath() {
+    path.clear();
+    pathCost = 0;
+    const uint8_t* cells = map->data();
+    for (int state = goalState; state != -1; state = context.parent[state]) {
+        int cell = state % cellCount;
+        path.push_back(map->indexToPosition(cell));
+        if (context.parent[state] != -1) {
+            pathCost += cells[cell] == TRAP ? trapCost : 1;
+        }
+    }
+    reverse(path.begin(), path.end());
+}
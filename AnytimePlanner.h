@@ -0,0 +1,99 @@
+// AnytimePlanner.h
+#ifndef ANYTIMEPLANNER_H
+#define ANYTIMEPLANNER_H
+
+#include "Map.h"
+#include "Position.h"
+#include "SearchContext.h"
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+
+// 随时可用的路径规划（ARA*）
+// 先用膨胀系数 ε > 1 的加权 A* 快速找到一条代价不超过最优 ε 倍的路径并发布，
+// 然后逐步减小 ε，复用已有的搜索结果（只重新处理代价变小的“不一致”状态）改进路径，
+// 直到 ε = 1 得到最优路径。每得到一条路径就通过回调发布一次。
+// 成本模型与带权搜索相同：进入普通格成本为1，陷阱格为 trapCost，可限制最多踩的陷阱数。
+// 搜索过程中定期检查取消标志，被取消时尽快返回。
+// 搜索状态按代号复用（见 SearchContext），同一个对象重复规划时不再清空数组。
+class AnytimePlanner {
+public:
+    // 膨胀系数以 1/EPSILON_SCALE 为单位
+    static constexpr int EPSILON_SCALE = 10;
+    static constexpr int INF = 0x3FFFFFFF;
+
+    // 发布路径的回调：路径（包含两端）、代价、次优上界 ε
+    typedef std::function<void(const std::vector<Position>& path, int cost, double epsilon)> SolutionCallback;
+
+private:
+    // 优先队列条目：key = g * EPSILON_SCALE + ε * h
+    struct Entry {
+        int64_t key;
+        int state;
+        int g;
+        bool operator>(const Entry& other) const { return key > other.key; }
+    };
+
+    enum StateFlag {
+        FLAG_OPEN = 1,
+        FLAG_CLOSED = 2,
+        FLAG_INCONS = 4
+    };
+
+    const Map* map;
+    int trapCost;
+    int maxTraps;          // -1 表示不限制
+    int trapLimit;         // 本次规划实际使用的上限（状态数过多时比 maxTraps 小）
+    int initialEpsilon;    // 以 1/EPSILON_SCALE 为单位
+    int epsilonStep;
+    bool cancelled;
+    int expandedCount;
+
+    int cellCount;
+    int goalCell;
+    int goalState;
+    int epsilon;
+    SearchContext context;         // g 值和父节点（按状态下标）
+    std::vector<uint8_t> flags;    // 只对本轮访问过的状态有效
+    std::vector<Entry> open;       // 二叉小顶堆（惰性删除）
+    std::vector<int> incons;
+    std::vector<int> closed;       // 本轮 ε 下扩展过的状态
+    std::vector<Position> path;
+    int pathCost;
+
+public:
+    AnytimePlanner(const Map* map);
+
+    // 切换到另一张地图（例如新的快照），下次规划时生效
+    void setMap(const Map* newMap) { map = newMap; }
+    void setTrapCost(int cost);
+    void setMaxTraps(int traps) { maxTraps = traps; }
+
+    // 初始膨胀系数和每轮的递减量，例如 (3.0, 0.5)
+    void setInflation(double initial, double step);
+
+    // 规划从 start 到 goal 的路径，每得到一条更好的路径调用一次 onSolution
+    // cancel 非空且被置位时尽快放弃；找到过至少一条路径返回 true
+    bool plan(const Position& start, const Position& goal, const SolutionCallback& onSolution,
+              const std::atomic<bool>* cancel = nullptr);
+
+    bool wasCancelled() const { return cancelled; }
+    int getExpandedCount() const { return expandedCount; }
+
+private:
+    int heuristic(int cell) const;
+    int gOf(int state) const { return context.isVisited(state) ? context.gCost[state] : INF; }
+    void push(int state);
+
+    // 在当前 ε 下扩展，直到开放列表中的最小 key 不小于终点的 key；被取消时返回 false
+    bool improvePath(const std::atomic<bool>* cancel);
+
+    // 减小 ε 后：开放列表并入不一致列表并按新 ε 重新排序，清空本轮的 CLOSED 标记
+    void reopen();
+
+    // 沿父节点取出路径并累计实际代价（父节点链上的 g 值可能已经变小，实际代价不超过 g(goal)）
+    void extractPath();
+};
+
+#endif
@@ -0,0 +1,120 @@
+// AsyncPlanner.cpp
+#include "AsyncPlanner.h"
+
+using namespace std;
+
+AsyncPlanner::AsyncPlanner()
+    : planner(nullptr), cancelRequested(false), running(false), hasJob(false), shuttingDown(false),
+      latestEpsilon(0), latestVersion(0) {
+    worker = thread(&AsyncPlanner::workerLoop, this);
+}
+
+AsyncPlanner::~AsyncPlanner() {
+    cancel();
+    {
+        lock_guard<mutex> lock(jobMutex);
+        shuttingDown = true;
+    }
+    jobReady.notify_one();
+    worker.join();
+}
+
+shared_future<PlanResult> AsyncPlanner::start(const Map& map, const Position& start, const Position& goal,
+                                              int trapCost, int maxTraps) {
+    cancel();
+
+    {
+        lock_guard<mutex> lock(latestMutex);
+        latestPath.clear();
+    }
+
+    // 后台线程只读自己的地图快照（只复制单元格），调用方可以继续修改原地图
+    Job job;
+    job.snapshot = make_shared<Map>(map.snapshot());
+    job.start = start;
+    job.goal = goal;
+    job.trapCost = trapCost;
+    job.maxTraps = maxTraps;
+    job.promise = make_shared<std::promise<PlanResult>>();
+    shared_future<PlanResult> future = job.promise->get_future().share();
+
+    {
+        lock_guard<mutex> lock(jobMutex);
+        pendingJob = std::move(job);
+        hasJob = true;
+        cancelRequested = false;
+        running = true;
+    }
+    jobReady.notify_one();
+
+    return future;
+}
+
+void AsyncPlanner::cancel() {
+    unique_lock<mutex> lock(jobMutex);
+    if (!running) {
+        return;
+    }
+    cancelRequested = true;
+    jobDone.wait(lock, [this]() { return !running; });
+}
+
+void AsyncPlanner::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            unique_lock<mutex> lock(jobMutex);
+            jobReady.wait(lock, [this]() { return hasJob || shuttingDown; });
+            if (shuttingDown) {
+                return;
+            }
+            job = std::move(pendingJob);
+            hasJob = false;
+        }
+
+        PlanResult result;
+        if (cancelRequested) {
+            result.cancelled = true;  // 还没开始就被取消
+        } else {
+            planner.setMap(job.snapshot.get());
+            planner.setTrapCost(job.trapCost);
+            planner.setMaxTraps(job.maxTraps);
+            result.found = planner.plan(job.start, job.goal,
+                [this, &result](const vector<Position>& path, int cost, double epsilon) {
+                    result.path = path;
+                    result.cost = cost;
+                    result.epsilon = epsilon;
+
+                    lock_guard<mutex> lock(latestMutex);
+                    latestPath = path;
+                    latestEpsilon = epsilon;
+                    latestVersion++;
+                },
+                &cancelRequested);
+            result.cancelled = planner.wasCancelled();
+            planner.setMap(nullptr);
+        }
+        job.snapshot.reset();  // 快照随任务结束释放
+        job.promise->set_value(std::move(result));
+
+        {
+            lock_guard<mutex> lock(jobMutex);
+            running = false;
+        }
+        jobDone.notify_all();
+    }
+}
+
+bool AsyncPlanner::fetch(uint64_t& version, vector<Position>& path, double& epsilon) const {
+    lock_guard<mutex> lock(latestMutex);
+    if (version == latestVersion) {
+        return false;
+    }
+    version = latestVersion;
+    if (latestPath.empty()) {
+        return false;  // 新任务开始后还没有发布路径
+    }
+    path = latestPath;
+    epsilon = latestEpsilon;
+    return true;
+}
@@ -0,0 +1,89 @@
+// AsyncPlanner.h
+#ifndef ASYNCPLANNER_H
+#define ASYNCPLANNER_H
+
+#include "Map.h"
+#include "Position.h"
+#include "AnytimePlanner.h"
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <cstdint>
+
+// 一次后台规划的最终结果
+struct PlanResult {
+    bool found;
+    bool cancelled;
+    int cost;                    // 最后发布的路径代价，找不到路径时为 -1
+    double epsilon;              // 最后发布的路径的次优上界，1 表示最优
+    std::vector<Position> path;  // 最后发布的路径（包含两端）
+
+    PlanResult() : found(false), cancelled(false), cost(-1), epsilon(0) {}
+};
+
+// 后台路径规划
+// start() 复制一份地图快照，在后台线程上运行 ARA*（见 AnytimePlanner.h）并立即返回一个 future。
+// 规划过程中每得到一条更好的路径就发布一次，调用方用 fetch() 取用最新路径，
+// 不必等待最终结果；cancel() 请求协作式取消并等待后台线程退出。
+// 同一时刻只运行一个任务，开始新任务前会先取消旧任务。
+// 后台线程在构造时创建、析构时退出，任务之间在条件变量上等待，不会为每次规划创建线程。
+// 发布的路径中 ε 为次优上界；后台线程正在运行时不要修改规划参数。
+class AsyncPlanner {
+private:
+    // 等待后台线程处理的任务
+    struct Job {
+        std::shared_ptr<Map> snapshot;
+        Position start, goal;
+        int trapCost;
+        int maxTraps;
+        std::shared_ptr<std::promise<PlanResult>> promise;
+    };
+
+    std::thread worker;
+    AnytimePlanner planner;  // 跨任务复用搜索状态，只由后台线程使用
+    std::atomic<bool> cancelRequested;  // 每个任务开始前复位
+    std::atomic<bool> running;          // 已提交的任务尚未完成
+
+    // 任务槽：jobMutex 保护 pendingJob、hasJob、shuttingDown 和 running 的修改
+    std::mutex jobMutex;
+    std::condition_variable jobReady;   // 有新任务或要求退出
+    std::condition_variable jobDone;    // 任务完成
+    Job pendingJob;
+    bool hasJob;
+    bool shuttingDown;
+
+    // 最新发布的路径（后台线程写入，调用方读取）
+    mutable std::mutex latestMutex;
+    std::vector<Position> latestPath;
+    double latestEpsilon;
+    uint64_t latestVersion;
+
+public:
+    AsyncPlanner();
+    ~AsyncPlanner();
+
+    AsyncPlanner(const AsyncPlanner&) = delete;
+    AsyncPlanner& operator=(const AsyncPlanner&) = delete;
+
+    // 开始规划从 start 到 goal 的路径；maxTraps 为 -1 时不限制踩陷阱的次数
+    std::shared_future<PlanResult> start(const Map& map, const Position& start, const Position& goal,
+                                         int trapCost, int maxTraps);
+
+    // 请求取消当前任务并等待它结束（没有任务时立即返回）
+    void cancel();
+
+    // 后台任务是否仍在运行
+    bool isRunning() const { return running.load(); }
+
+    // 取出 version 之后发布的最新路径并更新 version；没有新路径时返回 false
+    bool fetch(uint64_t& version, std::vector<Position>& path, double& epsilon) const;
+
+private:
+    void workerLoop();
+};
+
+#endif
@@ -0,0 +1,58 @@
+// BitGrid.cpp
+#include "BitGrid.h"
+#include <algorithm>
+
+using namespace std;
+
+BitGrid::BitGrid(int w, int h) : width(0), height(0), wordsPerRow(0) {
+    resize(w, h);
+}
+
+void BitGrid::resize(int w, int h) {
+    width = w;
+    height = h;
+    wordsPerRow = (w + 63) / 64;
+    words.assign(static_cast<size_t>(wordsPerRow) * h, 0);
+}
+
+void BitGrid::clear() {
+    fill(words.begin(), words.end(), 0);
+}
+
+// 第 w 个字中落在 [x0, x1] 区间内的位
+static inline uint64_t rangeMask(int w, int x0, int x1) {
+    int lo = max(x0 - w * 64, 0);
+    int hi = min(x1 - w * 64, 63);
+    uint64_t upper = hi == 63 ? ~uint64_t(0) : (uint64_t(1) << (hi + 1)) - 1;
+    return upper & (~uint64_t(0) << lo);
+}
+
+int BitGrid::setRange(int y, int x0, int x1) {
+    if (x0 > x1) return 0;
+    uint64_t* bits = row(y);
+    int added = 0;
+    for (int w = x0 >> 6; w <= (x1 >> 6); w++) {
+        uint64_t mask = rangeMask(w, x0, x1);
+        added += __builtin_popcountll(mask & ~bits[w]);
+        bits[w] |= mask;
+    }
+    return added;
+}
+
+void BitGrid::resetRange(int y, int x0, int x1) {
+    if (x0 > x1) return;
+    uint64_t* bits = row(y);
+    for (int w = x0 >> 6; w <= (x1 >> 6); w++) {
+        bits[w] &= ~rangeMask(w, x0, x1);
+    }
+}
+
+long long BitGrid::count() const {
+    const uint64_t* data = words.data();
+    size_t n = words.size();
+    long long total = 0;
+    for (size_t i = 0; i < n; i++) {
+        total += __builtin_popcountll(data[i]);
+    }
+    return total;
+}
@@ -0,0 +1,48 @@
+// BitGrid.h
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// 按位打包的二维网格，每行占 wordsPerRow 个 64 位字（行尾多余的位恒为0）
+class BitGrid {
+private:
+    std::vector<uint64_t> words;
+    int width, height;
+    int wordsPerRow;
+
+public:
+    BitGrid(int w = 0, int h = 0);
+
+    // 重新设置尺寸并清零
+    void resize(int w, int h);
+    void clear();
+
+    bool get(int x, int y) const {
+        return (words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1;
+    }
+    void set(int x, int y) {
+        words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] |= uint64_t(1) << (x & 63);
+    }
+    void reset(int x, int y) {
+        words[static_cast<size_t>(y) * wordsPerRow + (x >> 6)] &= ~(uint64_t(1) << (x & 63));
+    }
+
+    // 将第 y 行 [x0, x1] 区间置位，返回新置位的个数
+    int setRange(int y, int x0, int x1);
+    // 将第 y 行 [x0, x1] 区间清零
+    void resetRange(int y, int x0, int x1);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getWordsPerRow() const { return wordsPerRow; }
+    uint64_t* row(int y) { return words.data() + static_cast<size_t>(y) * wordsPerRow; }
+    const uint64_t* row(int y) const { return words.data() + static_cast<size_t>(y) * wordsPerRow; }
+
+    // 置位的格子数
+    long long count() const;
+};
+
+#endif
@@ -0,0 +1,54 @@
+// BucketQueue.h
+#ifndef BUCKETQUEUE_H
+#define BUCKETQUEUE_H
+
+#include <vector>
+
+// Dial 桶队列：键为小整数且单调不减时替代 std::priority_queue
+// 桶按键值循环使用，只要同时存在的键跨度不超过桶数即可，
+// 入队/出队均为 O(1)。reset 只清空桶内容，保留各桶容量以便复用。
+template <typename T>
+class BucketQueue {
+private:
+    std::vector<std::vector<T>> buckets;
+    int currentKey;  // 当前最小键
+    int count;
+    
+public:
+    BucketQueue() : currentKey(0), count(0) {}
+    
+    // keySpan：任意时刻队列中 最大键 - 最小键 的上界
+    void reset(int keySpan, int startKey) {
+        if (static_cast<int>(buckets.size()) < keySpan + 1) {
+            buckets.resize(keySpan + 1);
+        }
+        for (auto& bucket : buckets) {
+            bucket.clear();
+        }
+        currentKey = startKey;
+        count = 0;
+    }
+    
+    void push(int key, const T& value) {
+        buckets[key % buckets.size()].push_back(value);
+        count++;
+    }
+    
+    // 取出键最小的元素（同键元素后进先出）
+    T pop() {
+        std::vector<T>* bucket = &buckets[currentKey % buckets.size()];
+        while (bucket->empty()) {
+            currentKey++;
+            bucket = &buckets[currentKey % buckets.size()];
+        }
+        T value = bucket->back();
+        bucket->pop_back();
+        count--;
+        return value;
+    }
+    
+    int topKey() const { return currentKey; }
+    bool empty() const { return count == 0; }
+};
+
+#endif
@@ -0,0 +1,349 @@
+// CorridorGraph.cpp
+#include "CorridorGraph.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+CorridorGraph::CorridorGraph(const Map* map)
+    : map(map), trapCost(1), built(false), syncedRevision(0), expandedCount(0) {}
+
+void CorridorGraph::setTrapCost(int cost) {
+    // 边只记录步数，陷阱成本在搜索时计入，无需重建
+    trapCost = max(1, min(cost, 1000));
+}
+
+bool CorridorGraph::plan(const Position& start, const Position& goal, vector<Position>& path) {
+    path.clear();
+    expandedCount = 0;
+
+    if (map->getCell(start.x, start.y) == WALL || map->getCell(goal.x, goal.y) == WALL) {
+        return false;
+    }
+
+    if (!built || !syncMapChanges()) {
+        buildAll();
+    }
+
+    if (!map->isReachable(start, goal)) {
+        return false;
+    }
+
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    const int startCell = map->cellIndex(start.x, start.y);
+    const int goalCell = map->cellIndex(goal.x, goal.y);
+    if (startCell == goalCell) {
+        path.push_back(start);
+        return true;
+    }
+
+    const int startId = static_cast<int>(nodes.size());
+    const int goalId = startId + 1;
+    const bool startIsKey = nodeOf[startCell] >= 0;
+    const bool goalIsKey = nodeOf[goalCell] >= 0;
+    const int rootId = startIsKey ? nodeOf[startCell] : startId;
+    const int terminalId = goalIsKey ? nodeOf[goalCell] : goalId;
+
+    int steps, lastDirection;
+
+    // 终点在通道中时，找到通道两端的关键格，及从关键格走向终点的方向和代价
+    int goalEnd[2] = {-1, -1};
+    int goalCost[2] = {0, 0};
+    int goalDirection[2] = {0, 0};
+    if (!goalIsKey) {
+        int ends = 0;
+        for (int i = 0; i < 4 && ends < 2; i++) {
+            if (cells[goalCell + offsets[i]] == WALL) {
+                continue;
+            }
+            int end = trace(goalCell, i, -1, steps, lastDirection, nullptr);
+            if (end >= 0) {
+                goalEnd[ends] = end;
+                goalCost[ends] = steps;  // 途经的通道格和终点本身都不是陷阱
+                goalDirection[ends] = (lastDirection + 2) % 4;
+                ends++;
+            }
+        }
+    }
+
+    // 起点在通道中时，沿通道向两侧走到关键格（或直接走到同一通道上的终点）
+    int startEnd[2] = {-1, -1};
+    int startCost[2] = {0, 0};
+    int startDirection[2] = {0, 0};
+    if (!startIsKey) {
+        int ends = 0;
+        for (int i = 0; i < 4 && ends < 2; i++) {
+            if (cells[startCell + offsets[i]] == WALL) {
+                continue;
+            }
+            int end = trace(startCell, i, goalCell, steps, lastDirection, nullptr);
+            if (end >= 0) {
+                startEnd[ends] = end;
+                startCost[ends] = edgeCost(steps, end);
+                startDirection[ends] = i;
+                ends++;
+            }
+        }
+    }
+
+    // 在关键格上做 A*
+    context.prepare(goalId + 1);
+    viaDirection.resize(goalId + 1);
+    auto heuristic = [&](int cell) {
+        Position pos = map->indexToPosition(cell);
+        return abs(pos.x - goal.x) + abs(pos.y - goal.y);
+    };
+    auto relax = [&](const Node& from, int id, int cell, int cost, int direction) {
+        int newGCost = from.gCost + cost;
+        if (!context.isVisited(id) || newGCost < context.gCost[id]) {
+            context.visit(id, newGCost, from.index);
+            viaDirection[id] = static_cast<int8_t>(direction);
+            context.push(Node(id, newGCost, heuristic(cell)));
+        }
+    };
+
+    context.visit(rootId, 0, -1);
+    context.push(Node(rootId, 0, heuristic(startCell)));
+    bool found = false;
+
+    while (!context.empty()) {
+        Node current = context.pop();
+        if (current.gCost > context.gCost[current.index]) {
+            continue;
+        }
+        expandedCount++;
+
+        if (current.index == terminalId) {
+            found = true;
+            break;
+        }
+
+        if (current.index == startId) {
+            for (int i = 0; i < 2; i++) {
+                int end = startEnd[i];
+                if (end >= 0) {
+                    relax(current, nodeOf[end] >= 0 ? nodeOf[end] : goalId, end, startCost[i], startDirection[i]);
+                }
+            }
+            continue;
+        }
+
+        const KeyNode& node = nodes[current.index];
+        for (int i = 0; i < 4; i++) {
+            int target = node.target[i];
+            if (target < 0 || target == node.cell) {
+                continue;
+            }
+            relax(current, nodeOf[target], target, edgeCost(node.length[i], target), i);
+        }
+        for (int i = 0; i < 2; i++) {
+            if (goalEnd[i] == node.cell) {
+                relax(current, goalId, goalCell, goalCost[i], goalDirection[i]);
+            }
+        }
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    // 展开为逐格路径：从每个节点沿记录的方向走到下一个节点
+    idPath.clear();
+    for (int id = terminalId; id != -1; id = context.parent[id]) {
+        idPath.push_back(id);
+    }
+    reverse(idPath.begin(), idPath.end());
+
+    path.push_back(start);
+    int currentCell = startCell;
+    for (size_t i = 1; i < idPath.size(); i++) {
+        int id = idPath[i];
+        int targetCell = id == goalId ? goalCell : nodes[id].cell;
+        trace(currentCell, viaDirection[id], targetCell, steps, lastDirection, &path);
+        currentCell = targetCell;
+    }
+    return true;
+}
+
+void CorridorGraph::buildAll() {
+    nodes.clear();
+    freeNodes.clear();
+    nodeOf.assign(map->getCellCount(), -1);
+
+    for (int y = 0; y < map->getHeight(); y++) {
+        for (int x = 0; x < map->getWidth(); x++) {
+            int cell = map->cellIndex(x, y);
+            if (isKey(cell)) {
+                addNode(cell);
+            }
+        }
+    }
+    for (int id = 0; id < static_cast<int>(nodes.size()); id++) {
+        rebuildEdges(id);
+    }
+
+    syncedRevision = map->getRevision();
+    built = true;
+}
+
+bool CorridorGraph::syncMapChanges() {
+    if (map->getRevision() == syncedRevision) {
+        return true;
+    }
+    if (!map->getChangesSince(syncedRevision, changes)) {
+        return false;
+    }
+    syncedRevision = map->getRevision();
+
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+
+    // 只有变化格子及其邻居的度数或类型会变，关键格状态只需在这些格子上重新判定
+    affected.clear();
+    for (const CellChange& change : changes) {
+        int cell = map->cellIndex(change.x, change.y);
+        affected.push_back(cell);
+        for (int i = 0; i < 4; i++) {
+            affected.push_back(cell + offsets[i]);
+        }
+    }
+    sort(affected.begin(), affected.end());
+    affected.erase(unique(affected.begin(), affected.end()), affected.end());
+
+    for (int cell : affected) {
+        bool key = isKey(cell);
+        if (key && nodeOf[cell] < 0) {
+            addNode(cell);
+        } else if (!key && nodeOf[cell] >= 0) {
+            removeNode(cell);
+        }
+    }
+
+    // 边发生变化的关键格：这些格子本身，以及从它们出发沿通道走到的关键格
+    // （经过或终止于变化格子的通道，两端都能从变化格子附近走到）
+    dirtyNodes.clear();
+    int steps, lastDirection;
+    for (int cell : affected) {
+        if (cells[cell] == WALL) {
+            continue;
+        }
+        if (nodeOf[cell] >= 0) {
+            dirtyNodes.push_back(nodeOf[cell]);
+        }
+        for (int i = 0; i < 4; i++) {
+            if (cells[cell + offsets[i]] == WALL) {
+                continue;
+            }
+            int end = trace(cell, i, -1, steps, lastDirection, nullptr);
+            if (end >= 0 && nodeOf[end] >= 0) {
+                dirtyNodes.push_back(nodeOf[end]);
+            }
+        }
+    }
+    sort(dirtyNodes.begin(), dirtyNodes.end());
+    dirtyNodes.erase(unique(dirtyNodes.begin(), dirtyNodes.end()), dirtyNodes.end());
+    for (int id : dirtyNodes) {
+        rebuildEdges(id);
+    }
+    return true;
+}
+
+bool CorridorGraph::isKey(int cell) const {
+    const uint8_t* cells = map->data();
+    uint8_t type = cells[cell];
+    if (type == WALL) {
+        return false;
+    }
+    if (type != EMPTY) {
+        return true;  // 起点、终点、陷阱
+    }
+    const int stride = map->getStride();
+    int degree = (cells[cell - stride] != WALL) + (cells[cell + 1] != WALL) +
+                 (cells[cell + stride] != WALL) + (cells[cell - 1] != WALL);
+    return degree != 2;
+}
+
+int CorridorGraph::enterCost(int cell) const {
+    return map->data()[cell] == TRAP ? trapCost : 1;
+}
+
+void CorridorGraph::addNode(int cell) {
+    int id;
+    if (freeNodes.empty()) {
+        id = static_cast<int>(nodes.size());
+        nodes.push_back(KeyNode());
+    } else {
+        id = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    KeyNode& node = nodes[id];
+    node.cell = cell;
+    for (int i = 0; i < 4; i++) {
+        node.target[i] = -1;
+        node.length[i] = 0;
+    }
+    nodeOf[cell] = id;
+}
+
+void CorridorGraph::removeNode(int cell) {
+    int id = nodeOf[cell];
+    nodes[id].cell = -1;
+    for (int i = 0; i < 4; i++) {
+        nodes[id].target[i] = -1;
+    }
+    freeNodes.push_back(id);
+    nodeOf[cell] = -1;
+}
+
+void CorridorGraph::rebuildEdges(int id) {
+    KeyNode& node = nodes[id];
+    if (node.cell < 0) {
+        return;
+    }
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+    int lastDirection;
+    for (int i = 0; i < 4; i++) {
+        node.target[i] = -1;
+        if (cells[node.cell + offsets[i]] != WALL) {
+            node.target[i] = trace(node.cell, i, -1, node.length[i], lastDirection, nullptr);
+        }
+    }
+}
+
+int CorridorGraph::trace(int from, int direction, int stopCell, int& steps, int& lastDirection,
+                         vector<Position>* out) const {
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+
+    int current = from;
+    steps = 0;
+    while (true) {
+        int next = current + offsets[direction];
+        steps++;
+        lastDirection = direction;
+        if (out) {
+            out->push_back(map->indexToPosition(next));
+        }
+        if (next == stopCell || nodeOf[next] >= 0) {
+            return next;
+        }
+        if (next == from) {
+            return -1;  // 绕回出发点：没有关键格的环
+        }
+        // 通道格恰好有两个可通行邻居，继续走不是来路的那一个
+        int back = (direction + 2) % 4;
+        for (int i = 0; i < 4; i++) {
+            if (i != back && cells[next + offsets[i]] != WALL) {
+                direction = i;
+                break;
+            }
+        }
+        current = next;
+    }
+}
@@ -0,0 +1,84 @@
+// CorridorGraph.h
+#ifndef CORRIDORGRAPH_H
+#define CORRIDORGRAPH_H
+
+#include "Map.h"
+#include "Position.h"
+#include "SearchContext.h"
+#include <vector>
+#include <cstdint>
+
+// 通道收缩图
+// 恰好有两个可通行邻居的普通格子是“通道格”，其余可通行格子（路口、死胡同、起点、终点、陷阱）
+// 是“关键格”。每条通道收缩成两个关键格之间的一条带权边，搜索只在关键格上进行，
+// 找到后再沿通道展开为逐格路径。陷阱都是关键格，因此通道内部的每一步成本都是1，
+// 边的成本为 通道步数 - 1 + 进入终端关键格的成本（陷阱为 trapCost）。
+//
+// 地图变化通过 Map 的修改日志同步：变化格子及其邻居的关键格状态重新判定，
+// 再从这几个格子出发沿通道找到受影响的关键格，只重建它们的边。
+class CorridorGraph {
+public:
+    static constexpr int INF = 0x3FFFFFFF;
+
+private:
+    struct KeyNode {
+        int cell;          // 线性下标，-1 表示该编号空闲
+        int target[4];     // 按 上、右、下、左 方向出发到达的关键格（线性下标），-1 表示无边
+        int length[4];     // 对应通道的步数（含进入终端关键格的一步）
+    };
+
+    const Map* map;
+    int trapCost;
+    bool built;
+    uint64_t syncedRevision;
+    int expandedCount;
+
+    std::vector<KeyNode> nodes;
+    std::vector<int> freeNodes;
+    std::vector<int> nodeOf;        // 每个格子对应的关键格编号，非关键格为 -1
+    std::vector<CellChange> changes;
+    std::vector<int> affected;
+    std::vector<int> dirtyNodes;
+
+    // 搜索状态：编号 = 关键格编号，最后两个编号是临时接入的起点和终点
+    SearchContext context;
+    std::vector<int8_t> viaDirection;  // 到达该编号时从父节点出发的方向
+    std::vector<int> idPath;
+
+public:
+    CorridorGraph(const Map* map);
+
+    void setTrapCost(int cost);
+
+    // 规划从 start 到 goal 的路径（包含两端），找到路径返回 true
+    bool plan(const Position& start, const Position& goal, std::vector<Position>& path);
+
+    // 丢弃收缩图，下次规划时整体重建
+    void reset() { built = false; }
+
+    // 最近一次规划扩展的关键格数
+    int getLastExpandedCount() const { return expandedCount; }
+
+    // 当前关键格数（收缩后的图规模）
+    int getKeyNodeCount() const { return static_cast<int>(nodes.size() - freeNodes.size()); }
+
+private:
+    void buildAll();
+    bool syncMapChanges();
+
+    bool isKey(int cell) const;
+    int enterCost(int cell) const;
+    void addNode(int cell);
+    void removeNode(int cell);
+    void rebuildEdges(int id);
+
+    // 从 from 沿 direction 走进通道，直到遇到关键格或 stopCell；
+    // 返回停下的格子，通道是不含关键格的环时返回 -1。
+    // steps 为走过的步数，lastDirection 为最后一步的方向，out 非空时追加经过的格子（不含 from）
+    int trace(int from, int direction, int stopCell, int& steps, int& lastDirection,
+              std::vector<Position>* out) const;
+
+    int edgeCost(int steps, int endCell) const { return steps - 1 + enterCost(endCell); }
+};
+
+#endif
@@ -0,0 +1,286 @@
+// DistanceField.cpp
+#include "DistanceField.h"
+#include "SearchContext.h"
+#include <algorithm>
+#include <functional>
+
+using namespace std;
+
+DistanceField::DistanceField(const Map* map)
+    : map(map), goalIndex(-1), trapCost(1), trapBudget(-1), layers(1), cellCount(0),
+      built(false), syncedRevision(0) {}
+
+bool DistanceField::matches(const Position& goal, int cost, int budget) const {
+    if (!built || cellCount != map->getCellCount() ||
+        goalIndex != map->cellIndex(goal.x, goal.y) || cost != trapCost) {
+        return false;
+    }
+    // 不限制预算时需要单层场；限制预算时现有层数足够即可
+    if (budget < 0 || trapBudget < 0) {
+        return budget < 0 && trapBudget < 0;
+    }
+    return budget <= trapBudget;
+}
+
+void DistanceField::build(const Position& goal, int cost, int budget) {
+    trapCost = cost;
+    trapBudget = budget;
+    cellCount = map->getCellCount();
+    // 层数过多时只建前面几层，layerFor() 会把更大的预算压到最高层，结果只会更保守
+    layers = budget < 0 ? 1 : SearchContext::clampLayers(cellCount, budget + 1);
+    goalIndex = map->cellIndex(goal.x, goal.y);
+    syncedRevision = map->getRevision();
+    built = true;
+
+    dist.assign(static_cast<size_t>(cellCount) * layers, INF);
+    if (map->getCell(goal.x, goal.y) == WALL) {
+        return;
+    }
+
+    // 从终点的每一层反向做 Dial 搜索，每条边的代价不超过 trapCost
+    buckets.reset(trapCost, 0);
+    for (int k = 0; k < layers; k++) {
+        int state = k * cellCount + goalIndex;
+        dist[state] = 0;
+        buckets.push(0, state);
+    }
+
+    int preds[4];
+    while (!buckets.empty()) {
+        int state = buckets.pop();
+        int d = buckets.topKey();
+        if (d != dist[state]) {
+            continue;
+        }
+        int stepCost = enterCost(state % cellCount);
+        int count = predecessors(state, preds);
+        for (int i = 0; i < count; i++) {
+            int candidate = d + stepCost;
+            if (candidate < dist[preds[i]]) {
+                dist[preds[i]] = candidate;
+                buckets.push(candidate, preds[i]);
+            }
+        }
+    }
+}
+
+void DistanceField::update() {
+    if (!built || map->getRevision() == syncedRevision) {
+        return;
+    }
+
+    Position goal = map->indexToPosition(goalIndex);
+    if (!map->getChangesSince(syncedRevision, changes)) {
+        build(goal, trapCost, trapBudget);
+        return;
+    }
+    syncedRevision = map->getRevision();
+
+    const int stride = map->getStride();
+    const int offsets[] = {0, -stride, 1, stride, -1};
+
+    // 收集变化格子及其邻居的所有状态
+    seeds.clear();
+    for (const CellChange& change : changes) {
+        int index = map->cellIndex(change.x, change.y);
+        if (index == goalIndex) {
+            build(goal, trapCost, trapBudget);  // 终点本身变化，整体重建
+            return;
+        }
+        for (int i = 0; i < 5; i++) {
+            int cell = index + offsets[i];
+            for (int k = 0; k < layers; k++) {
+                seeds.push_back(k * cellCount + cell);
+            }
+        }
+    }
+
+    // 第一步：失效。某状态的代价已无法由后继支撑时置为无穷，并检查依赖它的前驱
+    // 代价沿支撑链严格递减，因此不会出现互相支撑的环
+    int preds[4];
+    invalidated.clear();
+    worklist.assign(seeds.begin(), seeds.end());
+    while (!worklist.empty()) {
+        int state = worklist.back();
+        worklist.pop_back();
+        if (dist[state] >= INF || state % cellCount == goalIndex) {
+            continue;
+        }
+        if (bestFromNeighbors(state) > dist[state]) {
+            dist[state] = INF;
+            invalidated.push_back(state);
+            int count = predecessors(state, preds);
+            worklist.insert(worklist.end(), preds, preds + count);
+        }
+    }
+
+    // 第二步：修复。失效状态和变化附近的状态从邻居重新取值，再向外松弛
+    heap.clear();
+    for (const vector<int>* group : {&invalidated, &seeds}) {
+        for (int state : *group) {
+            int best = bestFromNeighbors(state);
+            if (best < dist[state]) {
+                dist[state] = best;
+                pushHeap(best, state);
+            }
+        }
+    }
+    relaxFromHeap();
+}
+
+void DistanceField::pushHeap(int cost, int state) {
+    heap.push_back(make_pair(cost, state));
+    push_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+}
+
+void DistanceField::relaxFromHeap() {
+    int preds[4];
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), greater<pair<int, int>>());
+        pair<int, int> top = heap.back();
+        heap.pop_back();
+        int d = top.first;
+        int state = top.second;
+        if (d != dist[state]) {
+            continue;
+        }
+        int stepCost = enterCost(state % cellCount);
+        int count = predecessors(state, preds);
+        for (int i = 0; i < count; i++) {
+            int candidate = d + stepCost;
+            if (candidate < dist[preds[i]]) {
+                dist[preds[i]] = candidate;
+                pushHeap(candidate, preds[i]);
+            }
+        }
+    }
+}
+
+int DistanceField::enterCost(int index) const {
+    uint8_t type = map->data()[index];
+    if (type == WALL) return INF;
+    if (type == TRAP) return trapCost;
+    return 1;
+}
+
+int DistanceField::predecessors(int state, int* out) const {
+    // 从邻居 u 进入 v：v 为陷阱且启用预算时，前驱位于高一层
+    int cell = state % cellCount;
+    int layer = state / cellCount;
+    const uint8_t* cells = map->data();
+    if (cells[cell] == WALL) {
+        return 0;
+    }
+    int fromLayer = (trapBudget >= 0 && cells[cell] == TRAP) ? layer + 1 : layer;
+    if (fromLayer >= layers) {
+        return 0;
+    }
+
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+    int count = 0;
+    for (int i = 0; i < 4; i++) {
+        int neighbor = cell + offsets[i];
+        if (cells[neighbor] != WALL) {
+            out[count++] = fromLayer * cellCount + neighbor;
+        }
+    }
+    return count;
+}
+
+int DistanceField::bestFromNeighbors(int state) const {
+    int cell = state % cellCount;
+    int layer = state / cellCount;
+    const uint8_t* cells = map->data();
+    if (cell == goalIndex) {
+        return 0;
+    }
+    if (cells[cell] == WALL) {
+        return INF;
+    }
+
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+    int best = INF;
+    for (int i = 0; i < 4; i++) {
+        int neighbor = cell + offsets[i];
+        uint8_t type = cells[neighbor];
+        if (type == WALL) {
+            continue;
+        }
+        int toLayer = layer;
+        if (trapBudget >= 0 && type == TRAP) {
+            if (layer == 0) continue;
+            toLayer = layer - 1;
+        }
+        int d = dist[toLayer * cellCount + neighbor];
+        if (d < INF) {
+            best = min(best, d + enterCost(neighbor));
+        }
+    }
+    return best;
+}
+
+int DistanceField::layerFor(int trapsAllowed) const {
+    if (trapBudget < 0) {
+        return 0;
+    }
+    return max(0, min(trapsAllowed, layers - 1));
+}
+
+int DistanceField::getDistance(const Position& pos, int layer) const {
+    if (!built || !map->isValidPosition(pos.x, pos.y)) {
+        return -1;
+    }
+    int d = dist[layer * cellCount + map->cellIndex(pos.x, pos.y)];
+    return d >= INF ? -1 : d;
+}
+
+int DistanceField::nextCell(int index, int& layer) const {
+    const uint8_t* cells = map->data();
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+
+    int best = -1;
+    int bestLayer = layer;
+    int bestCost = INF;
+    for (int i = 0; i < 4; i++) {
+        int neighbor = index + offsets[i];
+        uint8_t type = cells[neighbor];
+        if (type == WALL) {
+            continue;
+        }
+        int toLayer = layer;
+        if (trapBudget >= 0 && type == TRAP) {
+            if (layer == 0) continue;
+            toLayer = layer - 1;
+        }
+        int d = dist[toLayer * cellCount + neighbor];
+        if (d < INF && d + enterCost(neighbor) < bestCost) {
+            bestCost = d + enterCost(neighbor);
+            best = neighbor;
+            bestLayer = toLayer;
+        }
+    }
+    layer = bestLayer;
+    return best;
+}
+
+bool DistanceField::extractPath(const Position& start, int layer, vector<Position>& path) const {
+    path.clear();
+    if (getDistance(start, layer) < 0) {
+        return false;
+    }
+
+    int index = map->cellIndex(start.x, start.y);
+    path.push_back(start);
+    while (index != goalIndex) {
+        index = nextCell(index, layer);
+        if (index == -1) {
+            path.clear();
+            return false;
+        }
+        path.push_back(map->indexToPosition(index));
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+// DistanceField.h
+#ifndef DISTANCEFIELD_H
+#define DISTANCEFIELD_H
+
+#include "Map.h"
+#include "Position.h"
+#include "BucketQueue.h"
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// 到终点的距离场
+// 从终点反向做一次 Dial 搜索（统一成本时即为 BFS），记录每个格子到终点的最小代价，
+// 之后每一步只需走向代价最小的邻居。进入普通格的成本为1，进入陷阱格的成本为 trapCost。
+//
+// 启用陷阱预算时按“还能再踩的陷阱数”分层：第 k 层表示最多还能踩 k 个陷阱，
+// 踩中陷阱会从第 k 层进入第 k-1 层，第0层不能再进入陷阱。
+//
+// 地图变化通过 Map 的修改日志同步：只在变化格子附近失效并重新松弛，不做整体重建。
+class DistanceField {
+private:
+    const Map* map;
+    int goalIndex;
+    int trapCost;
+    int trapBudget;   // 构建时的陷阱预算，-1 表示不限制（单层，陷阱不消耗预算）
+    int layers;
+    int cellCount;
+    bool built;
+    uint64_t syncedRevision;
+
+    std::vector<int> dist;           // 状态下标 = 层 * cellCount + 格子下标
+    BucketQueue<int> buckets;        // 整体构建用
+    std::vector<std::pair<int, int>> heap;  // 局部修复用的小顶堆 (代价, 状态)
+    std::vector<int> seeds;          // 局部更新：变化格子及其邻居的所有状态
+    std::vector<int> worklist;
+    std::vector<int> invalidated;
+    std::vector<CellChange> changes;
+
+public:
+    static constexpr int INF = 0x3FFFFFFF;
+
+    DistanceField(const Map* map);
+
+    // 以 goal 为终点整体构建
+    void build(const Position& goal, int trapCost, int trapBudget);
+
+    // 按地图修改日志局部更新；日志已截断时整体重建
+    void update();
+
+    bool isBuilt() const { return built; }
+    bool matches(const Position& goal, int cost, int budget) const;
+    int getTrapBudget() const { return trapBudget; }
+
+    // 在预算层 layer 上到终点的代价，不可达返回 -1
+    int getDistance(const Position& pos, int layer) const;
+
+    // 沿距离场下降一步：返回下一个格子的下标并更新 layer，无路可走时返回 -1
+    int nextCell(int index, int& layer) const;
+
+    // 从 start 沿距离场走到终点，写入逐格路径（包含两端）
+    bool extractPath(const Position& start, int layer, std::vector<Position>& path) const;
+
+    // 将预算（还能踩的陷阱数）换算为层号
+    int layerFor(int trapsAllowed) const;
+
+private:
+    int enterCost(int index) const;
+    // 由后继状态重新计算某个状态的最小代价
+    int bestFromNeighbors(int state) const;
+    // 列出可以一步走到 state 的前驱状态，返回个数
+    int predecessors(int state, int* out) const;
+
+    void pushHeap(int cost, int state);
+    void relaxFromHeap();
+};
+
+#endif
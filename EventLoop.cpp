@@ -0,0 +1,191 @@
+// EventLoop.cpp
+#include "EventLoop.h"
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <poll.h>
+    #include <unistd.h>
+    #include <sys/timerfd.h>
+    #include <cerrno>
+    #include <cstdint>
+#endif
+
+using namespace std;
+using namespace std::chrono;
+
+#ifdef _WIN32
+
+EventLoop::EventLoop(KeyReader& keys, int tickMs, int frameMs)
+    : keys(keys), tickMs(max(1, tickMs)), frameMs(max(0, frameMs)), ticking(false), frameRequested(false) {}
+
+EventLoop::~EventLoop() {}
+
+bool EventLoop::isOpen() const {
+    return true;
+}
+
+void EventLoop::setTicking(bool enabled) {
+    if (enabled && !ticking) {
+        nextTick = Clock::now() + milliseconds(tickMs);
+    }
+    ticking = enabled;
+}
+
+int EventLoop::wait(int& ticks) {
+    ticks = 0;
+    HANDLE input = GetStdHandle(STD_INPUT_HANDLE);
+
+    while (true) {
+        if (keys.pending() > 0) {
+            return LOOP_INPUT;  // 上次取出的按键还没处理完
+        }
+        
+        int timeout = frameTimeout();
+        if (ticking) {
+            int untilTick = static_cast<int>(max<long long>(0,
+                duration_cast<milliseconds>(nextTick - Clock::now()).count()));
+            timeout = timeout < 0 ? untilTick : min(timeout, untilTick);
+        }
+
+        // 控制台输入句柄在有任何输入事件（包括鼠标、焦点）时变为有信号
+        DWORD result = WaitForSingleObject(input, timeout < 0 ? INFINITE : static_cast<DWORD>(timeout));
+        if (result == WAIT_FAILED) {
+            return LOOP_CLOSED;
+        }
+        int events = LOOP_NONE;
+        if (result == WAIT_OBJECT_0) {
+            if (keys.fill() > 0) {
+                events |= LOOP_INPUT;
+            } else {
+                FlushConsoleInputBuffer(input);  // 丢弃非按键事件，否则句柄一直有信号
+            }
+        }
+
+        Clock::time_point now = Clock::now();
+        if (ticking && now >= nextTick) {
+            ticks = 1 + static_cast<int>(duration_cast<milliseconds>(now - nextTick).count() / tickMs);
+            nextTick += milliseconds(static_cast<long long>(ticks) * tickMs);
+            events |= LOOP_TICK;
+        }
+        if (frameTimeout() == 0) {
+            frameRequested = false;
+            lastFrame = now;
+            events |= LOOP_FRAME;
+        }
+        if (events != LOOP_NONE) {
+            return events;
+        }
+    }
+}
+
+#else
+
+EventLoop::EventLoop(KeyReader& keys, int tickMs, int frameMs)
+    : keys(keys), tickMs(max(1, tickMs)), frameMs(max(0, frameMs)), ticking(false), frameRequested(false) {
+    tickFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+}
+
+EventLoop::~EventLoop() {
+    if (tickFd >= 0) {
+        close(tickFd);
+    }
+}
+
+bool EventLoop::isOpen() const {
+    return tickFd >= 0;
+}
+
+void EventLoop::setTicking(bool enabled) {
+    if (tickFd < 0 || enabled == ticking) {
+        return;
+    }
+
+    // 第一次到期在一个周期之后，之后按固定周期到期；全零表示停止
+    struct itimerspec spec = {};
+    if (enabled) {
+        spec.it_interval.tv_sec = tickMs / 1000;
+        spec.it_interval.tv_nsec = static_cast<long>(tickMs % 1000) * 1000000L;
+        spec.it_value = spec.it_interval;
+    }
+    timerfd_settime(tickFd, 0, &spec, nullptr);
+    ticking = enabled;
+
+    if (!enabled) {
+        uint64_t expirations;
+        while (read(tickFd, &expirations, sizeof(expirations)) > 0) {}  // 丢弃停止前已到期的周期
+    }
+}
+
+int EventLoop::wait(int& ticks) {
+    ticks = 0;
+
+    while (true) {
+        if (keys.pending() > 0) {
+            return LOOP_INPUT;  // 上次取出的按键还没处理完
+        }
+        
+        struct pollfd fds[2];
+        int count = 0;
+        int inputSlot = -1, tickSlot = -1;
+        if (!keys.isClosed()) {
+            fds[count].fd = keys.getFd();
+            fds[count].events = POLLIN;
+            inputSlot = count++;
+        }
+        if (ticking) {
+            fds[count].fd = tickFd;
+            fds[count].events = POLLIN;
+            tickSlot = count++;
+        }
+
+        int timeout = frameTimeout();
+        if (count == 0 && timeout < 0) {
+            return LOOP_CLOSED;  // 没有任何可等待的事件，再等下去会永远阻塞
+        }
+
+        int ready = poll(fds, count, timeout);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;  // 被信号打断（例如终端窗口大小变化），重新计算超时再等
+            }
+            return LOOP_CLOSED;
+        }
+
+        int events = LOOP_NONE;
+        if (ready > 0) {
+            if (inputSlot >= 0 && (fds[inputSlot].revents & (POLLIN | POLLHUP | POLLERR))) {
+                // 一次取走全部已到达的按键；读到文件末尾时也返回，由调用方检查 isInputClosed()
+                keys.fill();
+                events |= LOOP_INPUT;
+            }
+            if (tickSlot >= 0 && (fds[tickSlot].revents & POLLIN)) {
+                // 读出的是上次读取之后到期的周期数，处理慢了也不会丢失时钟周期
+                uint64_t expirations = 0;
+                if (read(tickFd, &expirations, sizeof(expirations)) == sizeof(expirations) && expirations > 0) {
+                    ticks = static_cast<int>(min<uint64_t>(expirations, 1000));
+                    events |= LOOP_TICK;
+                }
+            }
+        }
+        if (frameTimeout() == 0) {
+            frameRequested = false;
+            lastFrame = Clock::now();
+            events |= LOOP_FRAME;
+        }
+        if (events != LOOP_NONE) {
+            return events;
+        }
+    }
+}
+
+#endif
+
+int EventLoop::frameTimeout() const {
+    if (!frameRequested) {
+        return -1;
+    }
+    long long elapsed = duration_cast<milliseconds>(Clock::now() - lastFrame).count();
+    return static_cast<int>(max(0LL, frameMs - elapsed));
+}
@@ -0,0 +1,73 @@
+// EventLoop.h
+#ifndef EVENTLOOP_H
+#define EVENTLOOP_H
+
+#include "Terminal.h"
+#include <chrono>
+
+// EventLoop::wait() 返回的事件（可以同时有多个）
+enum LoopEvent {
+    LOOP_NONE = 0,
+    LOOP_INPUT = 1,   // 标准输入有按键可读
+    LOOP_TICK = 2,    // 模拟时钟到期
+    LOOP_FRAME = 4,   // 画面需要重绘且已到帧期限
+    LOOP_CLOSED = 8   // 等待出错，或已没有任何可等待的事件；调用方应退出循环
+};
+
+// 单线程事件循环
+// 用 poll 同时等待标准输入和一个 timerfd（固定频率的模拟时钟），
+// 重绘请求按帧间隔合并：requestFrame() 之后在下一个帧期限到来时才返回 LOOP_FRAME，
+// 两次重绘之间的多次状态变化只画一帧。没有任何事件时 wait() 一直阻塞，不占用CPU。
+// 输入可读时一次取走全部已到达的按键（见 KeyReader），调用方用 readKey() 逐个处理。
+// 终端模式由调用方负责（见 Terminal::RawMode）。
+// Windows 上没有 timerfd，用控制台输入句柄的等待超时模拟。
+class EventLoop {
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    KeyReader& keys;
+    int tickMs;
+    int frameMs;
+    bool ticking;
+    bool frameRequested;
+    Clock::time_point lastFrame;
+
+#ifdef _WIN32
+    Clock::time_point nextTick;
+#else
+    int tickFd;  // timerfd，-1 表示不可用
+#endif
+
+public:
+    // keys：读取按键的缓冲；tickMs：模拟时钟周期；frameMs：两帧之间的最短间隔
+    EventLoop(KeyReader& keys, int tickMs, int frameMs);
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    // 计时器是否创建成功
+    bool isOpen() const;
+
+    // 开启/停止模拟时钟；停止时 wait() 只等待输入和重绘
+    void setTicking(bool enabled);
+    bool isTicking() const { return ticking; }
+
+    // 请求重绘（在下一个帧期限合并处理）
+    void requestFrame() { frameRequested = true; }
+
+    // 等待事件，返回 LoopEvent 的组合；ticks 为本次到期的时钟周期数（可能大于1）
+    // 被信号打断时继续等待，不会返回 LOOP_NONE
+    int wait(int& ticks);
+
+    // 从缓冲取一个按键（不阻塞），没有按键时返回 false
+    bool readKey(char& key) { return keys.next(key); }
+
+    // 标准输入已关闭且缓冲已取空（例如管道读完）
+    bool isInputClosed() const { return keys.isClosed(); }
+
+private:
+    int frameTimeout() const;  // 距离帧期限的毫秒数，没有重绘请求时为 -1
+};
+
+#endif
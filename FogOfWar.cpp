@@ -1,77 +1,158 @@
 // FogOfWar.cpp
 #include "FogOfWar.h"
-#include <cmath>
+#include "Map.h"
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
 
 FogOfWar::FogOfWar(int mapWidth, int mapHeight, int range) 
-    : width(mapWidth), height(mapHeight), visionRange(range) {
+    : exploredCount(0), width(mapWidth), height(mapHeight), visionRange(max(0, range)),
+      hasCenter(false), visionMode(VISION_RADIUS), occluders(nullptr) {
+    buildStencil();
     reset();
 }
 
 void FogOfWar::reset() {
-    fogGrid.resize(height, vector<FogState>(width, FOG_UNEXPLORED));
+    visible.resize(width, height);
+    explored.resize(width, height);
+    exploredCount = 0;  // resize 后全部清零
+    hasCenter = false;
+}
+
+void FogOfWar::buildStencil() {
+    // 与原来的 sqrt(dx² + dy²) <= visionRange 判定等价：dx² + dy² <= r²
+    int r2 = visionRange * visionRange;
+    stencil.assign(2 * visionRange + 1, 0);
+    for (int dy = -visionRange; dy <= visionRange; dy++) {
+        int dx = 0;
+        while ((dx + 1) * (dx + 1) + dy * dy <= r2) {
+            dx++;
+        }
+        stencil[dy + visionRange] = dx;
+    }
+}
+
+void FogOfWar::markWindow(const Position& center, bool lit) {
+    int yBegin = max(0, center.y - visionRange);
+    int yEnd = min(height - 1, center.y + visionRange);
+    for (int y = yBegin; y <= yEnd; y++) {
+        int span = stencil[y - center.y + visionRange];
+        int xBegin = max(0, center.x - span);
+        int xEnd = min(width - 1, center.x + span);
+        // 每行的跨度按字整体置位/清零
+        if (lit) {
+            visible.setRange(y, xBegin, xEnd);
+            exploredCount += explored.setRange(y, xBegin, xEnd);
+        } else {
+            visible.resetRange(y, xBegin, xEnd);
+        }
+    }
+}
+
+void FogOfWar::setVisionMode(VisionMode mode, const Map* map) {
+    occluders = map;
+    visionMode = (mode == VISION_SHADOWCAST && map != nullptr) ? VISION_SHADOWCAST : VISION_RADIUS;
 }
 
 void FogOfWar::updateVisibility(const Position& playerPos) {
-    // 先将所有当前可见区域标记为已探索
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (fogGrid[y][x] == FOG_VISIBLE) {
-                fogGrid[y][x] = FOG_EXPLORED;
-            }
+    // 只有上一次的视野窗口里可能有 FOG_VISIBLE，把它们降为已探索，
+    // 再点亮新的视野窗口；每步的代价只和视野半径有关，与地图大小无关
+    if (hasCenter) {
+        markWindow(lastCenter, false);
+    }
+    
+    if (visionMode == VISION_SHADOWCAST) {
+        // 阴影投射的可见区域是圆形窗口的子集，上面的降级同样适用
+        if (playerPos.x >= 0 && playerPos.x < width && playerPos.y >= 0 && playerPos.y < height) {
+            reveal(playerPos.x, playerPos.y);
         }
+        static const int octants[8][4] = {
+            {1, 0, 0, 1}, {0, 1, 1, 0}, {0, -1, 1, 0}, {-1, 0, 0, 1},
+            {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}
+        };
+        for (const auto& o : octants) {
+            castLight(playerPos, 1, 1.0, 0.0, o[0], o[1], o[2], o[3]);
+        }
+    } else {
+        markWindow(playerPos, true);
+    }
+    
+    lastCenter = playerPos;
+    hasCenter = true;
+}
+
+void FogOfWar::reveal(int x, int y) {
+    visible.set(x, y);
+    if (!explored.get(x, y)) {
+        explored.set(x, y);
+        exploredCount++;
     }
+}
+
+bool FogOfWar::blocksSight(int x, int y) const {
+    // 地图之外视为墙壁
+    return !occluders->isValidPosition(x, y) || occluders->getCell(x, y) == WALL;
+}
+
+void FogOfWar::castLight(const Position& center, int row, double start, double end,
+                         int xx, int xy, int yx, int yy) {
+    if (start < end) return;
     
-    // 更新玩家周围的视野
-    for (int y = max(0, playerPos.y - visionRange); 
-         y <= min(height - 1, playerPos.y + visionRange); y++) {
-        for (int x = max(0, playerPos.x - visionRange); 
-             x <= min(width - 1, playerPos.x + visionRange); x++) {
+    int r2 = visionRange * visionRange;
+    double newStart = 0.0;
+    
+    for (int j = row; j <= visionRange; j++) {
+        bool blocked = false;
+        int dy = -j;
+        for (int dx = -j; dx <= 0; dx++) {
+            // 当前格子左右两条边的斜率
+            double leftSlope = (dx - 0.5) / (dy + 0.5);
+            double rightSlope = (dx + 0.5) / (dy - 0.5);
+            if (start < rightSlope) continue;
+            if (end > leftSlope) break;
+            
+            int x = center.x + dx * xx + dy * xy;
+            int y = center.y + dx * yx + dy * yy;
+            bool inMap = x >= 0 && x < width && y >= 0 && y < height;
+            
+            // 墙壁本身可见，但会挡住后面的格子
+            if (inMap && dx * dx + dy * dy <= r2) {
+                reveal(x, y);
+            }
             
-            if (isInVisionRange(x, y, playerPos)) {
-                if (fogGrid[y][x] == FOG_UNEXPLORED) {
-                    fogGrid[y][x] = FOG_VISIBLE;
-                } else if (fogGrid[y][x] == FOG_EXPLORED) {
-                    fogGrid[y][x] = FOG_VISIBLE;  // 重新点亮已探索区域
+            bool wall = blocksSight(x, y);
+            if (blocked) {
+                if (wall) {
+                    newStart = rightSlope;
+                    continue;
                 }
+                blocked = false;
+                start = newStart;
+            } else if (wall && j < visionRange) {
+                // 墙壁开始：先递归处理墙前未被遮挡的扇形，之后从墙的另一侧继续
+                blocked = true;
+                castLight(center, j + 1, start, leftSlope, xx, xy, yx, yy);
+                newStart = rightSlope;
             }
         }
+        if (blocked) break;
     }
 }
 
-bool FogOfWar::isInVisionRange(int x, int y, const Position& center) const {
-    // 简单的圆形视野检测
-    int dx = x - center.x;
-    int dy = y - center.y;
-    double distance = sqrt(dx * dx + dy * dy);
-    return distance <= visionRange;
-}
-
 FogState FogOfWar::getFogState(int x, int y) const {
     if (x >= 0 && x < width && y >= 0 && y < height) {
-        return fogGrid[y][x];
+        if (visible.get(x, y)) return FOG_VISIBLE;
+        if (explored.get(x, y)) return FOG_EXPLORED;
     }
     return FOG_UNEXPLORED;
 }
 
 bool FogOfWar::isVisible(int x, int y) const {
-    FogState state = getFogState(x, y);
-    return state == FOG_VISIBLE || state == FOG_EXPLORED;
+    return x >= 0 && x < width && y >= 0 && y < height && explored.get(x, y);
 }
 
 float FogOfWar::getExploredPercent() const {
-    int explored = 0;
-    int total = width * height;
-    
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            if (fogGrid[y][x] != FOG_UNEXPLORED) {
-                explored++;
-            }
-        }
-    }
-    
-    return total > 0 ? (float)explored / total * 100.0f : 0.0f;
-}
\ No newline at end of file
+    long long total = static_cast<long long>(width) * height;
+    return total > 0 ? (float)exploredCount / total * 100.0f : 0.0f;
+}
@@ -3,6 +3,7 @@
 #define FOGOFWAR_H
 
 #include "Position.h"
+#include "BitGrid.h"
 #include <vector>
 #include <memory>
 
@@ -13,15 +14,38 @@ enum FogState {
 };
 
 
+// 视野计算方式
+enum VisionMode {
+    VISION_RADIUS = 0,      // 圆形视野，可以看穿墙壁
+    VISION_SHADOWCAST = 1   // 按八分区递归阴影投射，墙壁遮挡视线
+};
+
+class Map;
+
 class FogOfWar {
 private:
-    std::vector<std::vector<FogState>> fogGrid;
+    // 两个位平面：visible 为当前可见，explored 为曾经见过（包含当前可见）
+    BitGrid visible;
+    BitGrid explored;
+    long long exploredCount;  // explored 中置位的格子数，随视野更新增量维护
     int width, height;
     int visionRange;  // 视野范围
     
+    // 圆形视野的行跨度模板：stencil[dy + visionRange] 为该行向左右延伸的最大格数
+    std::vector<int> stencil;
+    Position lastCenter;  // 上一次更新视野时的玩家位置
+    bool hasCenter;
+    
+    VisionMode visionMode;
+    const Map* occluders;  // 阴影投射模式下提供墙壁的地图
+    
 public:
     FogOfWar(int mapWidth, int mapHeight, int range = 2);
     
+    // 切换视野计算方式；VISION_SHADOWCAST 需要提供地图（用于读取墙壁）
+    void setVisionMode(VisionMode mode, const Map* map = nullptr);
+    VisionMode getVisionMode() const { return visionMode; }
+    
     // 更新视野
     void updateVisibility(const Position& playerPos);
     
@@ -38,8 +62,20 @@ public:
     float getExploredPercent() const;
     
 private:
-    // 检查位置是否在视野范围内
-    bool isInVisionRange(int x, int y, const Position& center) const;
+    // 预计算视野模板（只用整数运算）
+    void buildStencil();
+    
+    // 以 center 为中心的视野窗口：lit 为 true 时点亮，否则降为已探索
+    void markWindow(const Position& center, bool lit);
+    
+    // 点亮一个格子并维护已探索计数
+    void reveal(int x, int y);
+    bool blocksSight(int x, int y) const;
+    
+    // 递归阴影投射：处理一个八分区中从 row 行开始、斜率在 [end, start] 之间的扇形
+    // (xx, xy, yx, yy) 把八分区局部坐标变换为地图坐标
+    void castLight(const Position& center, int row, double start, double end,
+                   int xx, int xy, int yx, int yy);
 };
 
 #endif
\ No newline at end of file
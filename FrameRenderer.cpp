@@ -0,0 +1,170 @@
+// FrameRenderer.cpp
+#include "FrameRenderer.h"
+#include <iostream>
+#include <cstdio>
+#include <algorithm>
+
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+FrameRenderer::FrameRenderer()
+    : width(0), height(0), fullRedraw(true), nextRow(0), cursorRow(0), cursorCol(0) {
+#ifdef _WIN32
+    // 让 Windows 控制台解析 ANSI 转义序列
+    HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+    DWORD mode = 0;
+    if (GetConsoleMode(console, &mode)) {
+        SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+#endif
+}
+
+void FrameRenderer::beginFrame(int cols) {
+    if (cols != width) {
+        width = cols;
+        front.assign(static_cast<size_t>(width) * height, UNKNOWN);
+        back.assign(static_cast<size_t>(width) * height, ' ');
+        fullRedraw = true;
+    } else {
+        fill(back.begin(), back.end(), uint32_t(' '));
+    }
+    nextRow = 0;
+    cursorRow = 0;
+    cursorCol = 0;
+}
+
+void FrameRenderer::ensureRows(int rows) {
+    if (rows <= height) return;
+    // 新增的行在终端上的内容未知，标记为必须重绘
+    front.resize(static_cast<size_t>(width) * rows, UNKNOWN);
+    back.resize(static_cast<size_t>(width) * rows, ' ');
+    height = rows;
+}
+
+int FrameRenderer::charWidth(uint32_t c) {
+    // 常见的东亚宽字符和表情符号区间
+    if ((c >= 0x1100 && c <= 0x115F) || (c >= 0x2E80 && c <= 0xA4CF) ||
+        (c >= 0xAC00 && c <= 0xD7A3) || (c >= 0xF900 && c <= 0xFAFF) ||
+        (c >= 0xFE30 && c <= 0xFE4F) || (c >= 0xFF00 && c <= 0xFF60) ||
+        (c >= 0xFFE0 && c <= 0xFFE6) || (c >= 0x1F300 && c <= 0x1FAFF)) {
+        return 2;
+    }
+    return 1;
+}
+
+int FrameRenderer::print(int row, int col, const string& text) {
+    if (row < 0 || col < 0) return col;
+    ensureRows(row + 1);
+    uint32_t* cells = back.data() + static_cast<size_t>(row) * width;
+
+    size_t i = 0;
+    while (i < text.size() && col < width) {
+        // 解码一个 UTF-8 码点（非法字节按单字节处理）
+        unsigned char lead = static_cast<unsigned char>(text[i]);
+        uint32_t codepoint = lead;
+        int length = 1;
+        if (lead >= 0xF0) { codepoint = lead & 0x07; length = 4; }
+        else if (lead >= 0xE0) { codepoint = lead & 0x0F; length = 3; }
+        else if (lead >= 0xC0) { codepoint = lead & 0x1F; length = 2; }
+        if (i + length > text.size()) length = 1;
+        for (int k = 1; k < length; k++) {
+            codepoint = (codepoint << 6) | (static_cast<unsigned char>(text[i + k]) & 0x3F);
+        }
+        i += length;
+
+        if (codepoint == '\n' || codepoint < 0x20) continue;
+        int w = charWidth(codepoint);
+        if (col + w > width) break;
+        cells[col] = codepoint;
+        if (w == 2) cells[col + 1] = WIDE_TAIL;
+        col += w;
+    }
+    return col;
+}
+
+void FrameRenderer::line(const string& text) {
+    cursorCol = print(nextRow, 0, text);
+    cursorRow = nextRow;
+    nextRow++;
+}
+
+void FrameRenderer::appendUtf8(string& dest, uint32_t c) {
+    if (c < 0x80) {
+        dest += static_cast<char>(c);
+    } else if (c < 0x800) {
+        dest += static_cast<char>(0xC0 | (c >> 6));
+        dest += static_cast<char>(0x80 | (c & 0x3F));
+    } else if (c < 0x10000) {
+        dest += static_cast<char>(0xE0 | (c >> 12));
+        dest += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        dest += static_cast<char>(0x80 | (c & 0x3F));
+    } else {
+        dest += static_cast<char>(0xF0 | (c >> 18));
+        dest += static_cast<char>(0x80 | ((c >> 12) & 0x3F));
+        dest += static_cast<char>(0x80 | ((c >> 6) & 0x3F));
+        dest += static_cast<char>(0x80 | (c & 0x3F));
+    }
+}
+
+void FrameRenderer::present() {
+    writeOut(composeDiff());
+}
+
+const string& FrameRenderer::composeDiff() {
+    out.clear();
+    out += "\033[?25l";  // 绘制期间隐藏光标
+    if (fullRedraw) {
+        // 清屏后终端全是空格，只需输出非空格的格子
+        out += "\033[2J\033[H";
+        fill(front.begin(), front.end(), uint32_t(' '));
+        fullRedraw = false;
+    }
+
+    // 终端光标的当前位置，-1 表示未知
+    int termRow = -1, termCol = -1;
+    char move[32];
+
+    for (int y = 0; y < height; y++) {
+        const uint32_t* next = back.data() + static_cast<size_t>(y) * width;
+        const uint32_t* prev = front.data() + static_cast<size_t>(y) * width;
+        for (int x = 0; x < width; x++) {
+            if (next[x] == prev[x] || next[x] == WIDE_TAIL) {
+                continue;  // 宽字符的右半格随左半格一起输出
+            }
+            if (termRow != y || termCol != x) {
+                snprintf(move, sizeof(move), "\033[%d;%dH", y + 1, x + 1);
+                out += move;
+            }
+            appendUtf8(out, next[x]);
+            termRow = y;
+            termCol = x + charWidth(next[x]);
+        }
+    }
+
+    snprintf(move, sizeof(move), "\033[%d;%dH", cursorRow + 1, cursorCol + 1);
+    out += move;
+    out += "\033[?25h";
+
+    front.swap(back);
+    return out;
+}
+
+void FrameRenderer::writeOut(const string& data) {
+    cout.flush();  // 先输出 iostream 中残留的内容，避免顺序错乱
+#ifdef _WIN32
+    fwrite(data.data(), 1, data.size(), stdout);
+    fflush(stdout);
+#else
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t n = ::write(STDOUT_FILENO, data.data() + written, data.size() - written);
+        if (n <= 0) break;
+        written += static_cast<size_t>(n);
+    }
+#endif
+}
@@ -0,0 +1,56 @@
+// FrameRenderer.h
+#ifndef FRAMERENDERER_H
+#define FRAMERENDERER_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// 双缓冲差量渲染
+// 每帧先写入后台缓冲（按终端列存放 Unicode 码点），再与上一帧逐格比较，
+// 只输出变化的格子：用 ANSI 光标定位跳过未变化的部分，整帧拼成一个字符串后一次 write()。
+// 中文等宽字符占两列，第二列存放 WIDE_TAIL 标记。
+class FrameRenderer {
+private:
+    static constexpr uint32_t WIDE_TAIL = 0xFFFFFFFEu;  // 宽字符的右半格
+    static constexpr uint32_t UNKNOWN = 0xFFFFFFFFu;    // 屏幕内容未知，必定重绘
+
+    int width, height;
+    std::vector<uint32_t> front;  // 终端上当前显示的内容
+    std::vector<uint32_t> back;   // 正在组装的下一帧
+    bool fullRedraw;
+    int nextRow;                  // line() 的下一行
+    int cursorRow, cursorCol;     // 帧输出后光标停留的位置
+    std::string out;              // 复用的输出缓冲
+
+public:
+    FrameRenderer();
+
+    // 开始新的一帧，cols 为帧宽度（列数），宽度变化时整屏重绘
+    void beginFrame(int cols);
+
+    // 在 (row, col) 写入 UTF-8 文本，超出宽度的部分被截断，返回写入后的列号
+    int print(int row, int col, const std::string& text);
+
+    // 在下一行写入文本，光标停在文本末尾
+    void line(const std::string& text);
+
+    // 将差量输出到终端
+    void present();
+    
+    // 只生成本帧的差量输出并切换缓冲，不写终端（供基准测试和测试使用）
+    const std::string& composeDiff();
+
+    // 终端被其他输出覆盖后调用，下一帧整屏重绘
+    void invalidate() { fullRedraw = true; }
+
+    // 码点占用的终端列数（1 或 2）
+    static int charWidth(uint32_t codepoint);
+
+private:
+    void ensureRows(int rows);
+    static void appendUtf8(std::string& dest, uint32_t codepoint);
+    static void writeOut(const std::string& data);
+};
+
+#endif
@@ -1,46 +1,44 @@
 // Game.cpp
 #include "Game.h"
 #include <iostream>
-#include <limits>
-#include <chrono>
-#include <thread>
+#include <cstdlib>
+#include <sstream>
+#include <algorithm>
+#include <iomanip>
 
 #ifdef _WIN32
-    #include <conio.h>
-    #include <windows.h>
     #define CLEAR_SCREEN "cls"
-    #define SLEEP(ms) Sleep(ms)
-#else
-    #include <termios.h>
-    #include <unistd.h>
-    #define CLEAR_SCREEN "clear"
-    #define SLEEP(ms) usleep(ms * 1000)
-    
-    int getch() {
-        struct termios oldt, newt;
-        int ch;
-        tcgetattr(STDIN_FILENO, &oldt);
-        newt = oldt;
-        newt.c_lflag &= ~(ICANON | ECHO);
-        tcsetattr(STDIN_FILENO, TCSANOW, &newt);
-        ch = getchar();
-        tcsetattr(STDIN_FILENO, TCSANOW, &oldt);
-        return ch;
-    }
 #endif
 
 using namespace std;
-using namespace std::chrono;
 
-Game::Game() : gameRunning(true), currentMap(nullptr), 
-               fogModeEnabled(false), autoModeEnabled(false),
-               currentPathIndex(0), autoMoveDelay(500) {
+Game::Game() : currentMap(nullptr), gameRunning(true),
+               fogModeEnabled(false), visionMode(VISION_RADIUS), autoModeEnabled(false),
+               autoModeRunning(false), autoModeBlocked(false), autoMoveDelay(500), ticksSinceMove(0) {
     maps.push_back(Map::createMap1());
     maps.push_back(Map::createMap2());
 }
 
 Game::~Game() {
-    stopAutoMode();  // 确保线程安全退出
+    stopAutoMode();  // 取消仍在运行的后台规划
+}
+
+void Game::clearScreen() {
+    // 用 ANSI 转义序列清屏，不再每帧启动一个 shell 进程
+#ifdef _WIN32
+    system(CLEAR_SCREEN);
+#else
+    cout << "\033[2J\033[H" << flush;
+#endif
+}
+
+void Game::waitForKey() {
+    // 替代 system("pause")（Linux 上并不存在 pause 命令）
+    cout << "按任意键继续..." << flush;
+    Terminal::RawMode rawMode;  // 对局中已处于原始模式时不再切换
+    char key;
+    keys.wait(key);
+    cout << "\n";
 }
 
 void Game::run() {
@@ -50,13 +48,13 @@ void Game::run() {
 }
 
 void Game::showMainMenu() {
-    system(CLEAR_SCREEN);
+    clearScreen();
     
     cout << "====== 迷宫探险游戏 ======\n";
     cout << "1. 开始游戏\n";
     cout << "2. 选择地图\n";
-    cout << "3. " << (fogModeEnabled ? "禁用" : "启用") << "迷雾模式";
-    if (fogModeEnabled) cout << " [已启用]";
+    cout << "3. 切换迷雾模式";
+    if (fogModeEnabled) cout << (visionMode == VISION_SHADOWCAST ? " [视线遮挡]" : " [圆形视野]");
     cout << "\n";
     cout << "4. " << (autoModeEnabled ? "禁用" : "启用") << "自动模式";
     if (autoModeEnabled) cout << " [已启用]";
@@ -64,8 +62,14 @@ void Game::showMainMenu() {
     cout << "5. 退出游戏\n";
     cout << "请选择: ";
     
-    char choice;
-    cin >> choice;
+    // 菜单和对局共用同一个按键缓冲，管道输入时不会有字节被 cin 的缓冲截走
+    string line;
+    if (!keys.readLine(line)) {
+        gameRunning = false;  // 输入已关闭
+        return;
+    }
+    size_t first = line.find_first_not_of(" \t");
+    char choice = first == string::npos ? '\0' : line[first];
     
     switch (choice) {
         case '1':
@@ -89,8 +93,7 @@ void Game::showMainMenu() {
             break;
         default:
             cout << "无效选择，请重新输入！\n";
-            cin.ignore(numeric_limits<streamsize>::max(), '\n');
-            cin.get();
+            keys.readLine(line);  // 等待回车
             break;
     }
 }
@@ -99,401 +102,362 @@ void Game::toggleAutoMode() {
     autoModeEnabled = !autoModeEnabled;
     cout << "自动模式 " << (autoModeEnabled ? "已启用" : "已禁用") << "！\n";
     
-    if (autoModeEnabled && currentMap != nullptr) {
-        pathFinder = make_unique<PathFinder>(currentMap);
-    } else {
+    if (!autoModeEnabled) {
         stopAutoMode();
-        pathFinder.reset();
     }
     
-    system("pause");
+    waitForKey();
 }
 
 void Game::toggleFogMode() {
-    fogModeEnabled = !fogModeEnabled;
-    cout << "迷雾模式 " << (fogModeEnabled ? "已启用" : "已禁用") << "！\n";
-    
-    if (fogModeEnabled && currentMap != nullptr) {
-        fogOfWar = make_unique<FogOfWar>(
-            currentMap->getWidth(), 
-            currentMap->getHeight(), 
-            2
-        );
+    // 依次切换：关闭 -> 圆形视野 -> 视线遮挡（墙壁挡住视线） -> 关闭
+    if (!fogModeEnabled) {
+        fogModeEnabled = true;
+        visionMode = VISION_RADIUS;
+        cout << "迷雾模式 已启用（圆形视野）！\n";
+    } else if (visionMode == VISION_RADIUS) {
+        visionMode = VISION_SHADOWCAST;
+        cout << "迷雾模式 已启用（视线遮挡）！\n";
     } else {
-        fogOfWar.reset();
+        fogModeEnabled = false;
+        visionMode = VISION_RADIUS;
+        cout << "迷雾模式 已禁用！\n";
     }
     
-    system("pause");
+    waitForKey();
 }
 
 void Game::selectMap() {
-    system(CLEAR_SCREEN);
+    clearScreen();
     cout << "====== 选择地图 ======\n";
     for (size_t i = 0; i < maps.size(); i++) {
         cout << i + 1 << ". " << maps[i].getName() << "\n";
     }
     cout << "请选择地图: ";
     
-    int choice;
-    cin >> choice;
+    string line;
+    keys.readLine(line);
+    int choice = atoi(line.c_str());
     
     if (choice >= 1 && choice <= static_cast<int>(maps.size())) {
         currentMap = &maps[choice - 1];
         cout << "已选择: " << currentMap->getName() << "\n";
-        
-        // 重新初始化相关系统
-        if (fogModeEnabled) {
-            fogOfWar = make_unique<FogOfWar>(
-                currentMap->getWidth(), 
-                currentMap->getHeight(), 
-                2
-            );
-        }
-        
-        if (autoModeEnabled) {
-            pathFinder = make_unique<PathFinder>(currentMap);
-        }
     } else {
         cout << "无效选择！\n";
     }
-    system("pause");
+    waitForKey();
 }
 
 void Game::playGame() {
     if (currentMap == nullptr) return;
     
-    // 初始化玩家位置
-    Position startPos = currentMap->getStartPosition();
-    player = Player(startPos.x, startPos.y, 100);
-    player.setPosition(startPos);
+    // 每局使用一份新的地图副本，规则由 GameSession 负责
+    stopAutoMode();  // 确保之前的自动模式已停止
+    session = make_unique<GameSession>(*currentMap, fogModeEnabled, autoModeEnabled, visionMode);
     
-    // 初始化系统
-    if (fogModeEnabled) {
-        fogOfWar = make_unique<FogOfWar>(
-            currentMap->getWidth(), 
-            currentMap->getHeight(), 
-            2
-        );
-        fogOfWar->updateVisibility(player.getPosition());
-    }
+    // 整局（包括结束画面）只切换一次终端模式，退出或被信号终止时自动恢复
+    Terminal::RawMode rawMode;
     
-    if (autoModeEnabled) {
-        pathFinder = make_unique<PathFinder>(currentMap);
-        stopAutoMode();  // 确保之前的自动模式已停止
-        currentPath.clear();
-        currentPathIndex = 0;
+    // 输入、自动模式的时钟和重绘都在这一个线程上处理：
+    // 每一帧都在两次状态更新之间组装，看到的总是一致的对局状态
+    EventLoop loop(keys, TICK_MS, FRAME_MS);
+    if (!loop.isOpen()) {
+        cout << "无法创建计时器！\n";
+        waitForKey();
+        return;
     }
     
-    bool gameWon = false;
+    renderer.invalidate();  // 菜单用普通输出覆盖过屏幕，第一帧整屏绘制
+    string message;         // 显示在画面底部的提示
+    loop.requestFrame();
     
-    while (player.isAlive() && !gameWon) {
-        system(CLEAR_SCREEN);
-        displayGameState();
-        
-        // 自动模式处理
-        if (autoModeEnabled && !autoModeRunning) {
-            cout << "按 SPACE 开始自动寻路，Q退出: ";
-        } else if (!autoModeEnabled) {
-            cout << "使用 WASD 移动 (Q退出): ";
-        } else {
-            cout << "自动模式运行中... 按 SPACE 停止，Q退出\n";
-        }
-        
-        char input;
-        #ifdef _WIN32
-            input = _getch();
-        #else
-            input = getch();
-        #endif
-        
-        if (input == 'q' || input == 'Q') {
-            stopAutoMode();
+    while (!session->isOver()) {
+        int ticks;
+        int events = loop.wait(ticks);
+        if (events & LOOP_CLOSED) {
+            stopAutoMode();  // 输入和计时器都已无法等待，继续循环只会空转
             return;
         }
         
-        if (autoModeEnabled) {
-            if (input == ' ' && !autoModeRunning) {
-                // 开始自动模式
-                if (calculatePath()) {
-                    startAutoMode();
-                } else {
-                    cout << "无法找到路径到终点！\n";
-                    system("pause");
-                }
-            } else if (input == ' ' && autoModeRunning) {
-                // 停止自动模式
-                stopAutoMode();
-            }
-        } else {
-            // 手动模式
-            if (player.move(input, *currentMap)) {
-                Position playerPos = player.getPosition();
-                CellType currentCell = currentMap->getCell(playerPos.x, playerPos.y);
+        if (events & LOOP_INPUT) {
+            char input;
+            while (loop.readKey(input)) {
+                message.clear();
                 
-                // 更新迷雾视野
-                if (fogModeEnabled) {
-                    fogOfWar->updateVisibility(playerPos);
+                if (input == 'q' || input == 'Q') {
+                    stopAutoMode();
+                    return;
                 }
                 
-                // 检查陷阱
-                if (currentCell == TRAP) {
-                    player.takeDamage(30);
-                    cout << "你踩中了陷阱！失去30点生命值！\n";
-                    const_cast<Map*>(currentMap)->setCell(playerPos.x, playerPos.y, EMPTY);
-                    system("pause");
+                if (autoModeEnabled) {
+                    if (input == ' ' && !autoModeRunning) {
+                        // 开始自动模式：路径在后台规划，不阻塞输入
+                        session->planPathAsync();
+                        startAutoMode();
+                    } else if (input == ' ' && autoModeRunning) {
+                        // 停止自动模式
+                        stopAutoMode();
+                    }
+                } else {
+                    // 手动模式
+                    int moveEvents = session->applyMove(input);
+                    if (moveEvents & EVENT_TRAP) {
+                        message = "你踩中了陷阱！失去" + to_string(GameSession::TRAP_DAMAGE) + "点生命值！";
+                    }
                 }
-                
-                // 检查是否到达终点
-                if (currentCell == END) {
-                    gameWon = true;
+                loop.requestFrame();
+                if (session->isOver()) {
+                    break;
                 }
             }
+            if (loop.isInputClosed()) {
+                stopAutoMode();
+                return;
+            }
         }
         
-        // 检查自动模式是否完成
-        if (autoModeRunning) {
-            Position playerPos = player.getPosition();
-            CellType currentCell = currentMap->getCell(playerPos.x, playerPos.y);
-            if (currentCell == END) {
-                gameWon = true;
-                stopAutoMode();
+        if ((events & LOOP_TICK) && updateAutoMode(ticks)) {
+            loop.requestFrame();
+        }
+        loop.setTicking(autoModeRunning);
+        
+        if (events & LOOP_FRAME) {
+            displayGameState(renderer);
+            if (!message.empty()) {
+                renderer.line(message);
             }
+            
+            // 自动模式处理
+            if (autoModeEnabled && !autoModeRunning) {
+                renderer.line("按 SPACE 开始自动寻路，Q退出: ");
+            } else if (!autoModeEnabled) {
+                renderer.line("使用 WASD 移动 (Q退出): ");
+            } else {
+                renderer.line("自动模式运行中... 按 SPACE 停止，Q退出");
+            }
+            renderer.present();
         }
     }
     
     stopAutoMode();
-    showGameOver(gameWon);
-    system("pause");
-}
-
-bool Game::calculatePath() {
-    if (!pathFinder) return false;
-    
-    Position start = player.getPosition();
-    Position end = currentMap->getEndPosition();
-    
-    currentPath = pathFinder->findPath(start, end);
-    currentPathIndex = 0;
-    
-    return !currentPath.empty();
+    showGameOver(session->getStatus() == GAME_WON);
+    waitForKey();
 }
 
 void Game::startAutoMode() {
-    if (currentPath.empty() || autoModeRunning) return;
+    if (!session || autoModeRunning) return;
     
+    autoModeBlocked = false;
     autoModeRunning = true;
-    autoModeThread = thread(&Game::autoModeWorker, this);
+    ticksSinceMove = autoMoveDelay / TICK_MS;  // 拿到路径后立即走第一步
 }
 
 void Game::stopAutoMode() {
     autoModeRunning = false;
-    if (autoModeThread.joinable()) {
-        autoModeThread.join();
-    }
-}
-
-void Game::autoModeWorker() {
-    while (autoModeRunning && currentPathIndex < currentPath.size()) {
-        performAutoMove();
-        SLEEP(autoMoveDelay);
-        
-        // 检查是否到达终点
-        Position playerPos = player.getPosition();
-        if (playerPos == currentMap->getEndPosition()) {
-            break;
-        }
+    if (session) {
+        session->cancelPlanning();
     }
-    autoModeRunning = false;
 }
 
-void Game::performAutoMove() {
-    if (currentPathIndex >= currentPath.size()) {
-        stopAutoMode();
-        return;
+bool Game::updateAutoMode(int ticks) {
+    if (!autoModeRunning || session->isOver()) {
+        return false;
     }
     
-    // 获取下一个目标位置
-    Position nextPos = currentPath[currentPathIndex];
+    // 后台规划每改进一次路径就换用新路径
+    bool changed = session->pollPlan();
+    if (!session->hasPath()) {
+        if (!session->isPlanning() && !session->pollPlan()) {
+            autoModeBlocked = true;  // 规划已结束仍没有路径
+            autoModeRunning = false;
+            return true;
+        }
+        return changed;  // 等待第一条路径
+    }
     
-    // 计算移动方向
-    char direction = pathFinder->getNextMove(player.getPosition(), nextPos);
+    // 每 autoMoveDelay 毫秒走一步；处理慢了积压的周期最多补走一步，避免画面跳跃
+    ticksSinceMove += ticks;
+    if (ticksSinceMove < autoMoveDelay / TICK_MS) {
+        return changed;
+    }
+    ticksSinceMove = 0;
     
-    // 执行移动
-    if (player.move(direction, *currentMap)) {
-        Position playerPos = player.getPosition();
-        CellType currentCell = currentMap->getCell(playerPos.x, playerPos.y);
-        
-        // 更新迷雾视野
-        if (fogModeEnabled) {
-            fogOfWar->updateVisibility(playerPos);
-        }
-        
-        // 检查陷阱
-        if (currentCell == TRAP) {
-            player.takeDamage(30);
-            // 陷阱消失
-            const_cast<Map*>(currentMap)->setCell(playerPos.x, playerPos.y, EMPTY);
-        }
-        
-        currentPathIndex++;
-    } else {
-        // 移动失败，重新计算路径
-        stopAutoMode();
-        calculatePath();
-        if (!currentPath.empty()) {
-            startAutoMode();
-        }
+    int events = session->stepAlongPath();
+    if (events & EVENT_BLOCKED) {
+        autoModeRunning = false;
     }
+    return true;
 }
 
-void Game::displayGameState() const {
-    if (currentMap == nullptr) return;
-    
-    cout << "=== " << currentMap->getName() << " ===\n";
-    cout << "生命值: " << player.getHealth() << "/" << player.getMaxHealth();
-    cout << " (" << player.getHealthPercent() << "%)\n";
-    cout << "步数: " << player.getSteps() << "\n";
-    
-    if (fogModeEnabled && fogOfWar) {
-        cout << "探索进度: " << fogOfWar->getExploredPercent() << "%\n";
+void Game::displayGameState(FrameRenderer& frame) const {
+    if (!session) return;
+    
+    const Map& map = session->getMap();
+    const Player& player = session->getPlayer();
+    const vector<Position>& currentPath = session->getPath();
+    size_t currentPathIndex = session->getPathIndex();
+    
+    // 帧宽度至少容纳状态栏和图例
+    frame.beginFrame(max(map.getWidth() * 2, 100));
+    
+    ostringstream text;
+    text << "=== " << map.getName() << " ===";
+    frame.line(text.str());
+    
+    text.str("");
+    text << "生命值: " << player.getHealth() << "/" << player.getMaxHealth()
+         << " (" << player.getHealthPercent() << "%)";
+    frame.line(text.str());
+    
+    text.str("");
+    text << "步数: " << player.getSteps();
+    frame.line(text.str());
+    
+    if (session->getFogOfWar()) {
+        text.str("");
+        text << "探索进度: " << session->getFogOfWar()->getExploredPercent() << "%";
+        frame.line(text.str());
     }
     
     if (autoModeEnabled) {
-        cout << "自动模式: " << (autoModeRunning ? "运行中" : "就绪") << "\n";
+        frame.line(string("自动模式: ") + (autoModeRunning ? "运行中" : "就绪"));
+        if (autoModeBlocked) {
+            frame.line("无法找到路径到终点！");
+        } else if (autoModeRunning && currentPath.empty()) {
+            frame.line("路径规划中...");
+        } else if (autoModeRunning) {
+            text.str("");
+            text << "到终点的路径代价: " << session->getRemainingPathCost();
+            frame.line(text.str());
+            
+            text.str("");
+            text << "路径质量: 不超过最优的 " << fixed << setprecision(2) << session->getPlanEpsilon() << " 倍"
+                 << (session->isPlanning() ? "（改进中）" : "");
+            frame.line(text.str());
+        }
         if (!currentPath.empty() && autoModeRunning) {
-            cout << "路径进度: " << currentPathIndex << "/" << currentPath.size() << "\n";
+            text.str("");
+            text << "路径进度: " << currentPathIndex << "/" << currentPath.size();
+            frame.line(text.str());
         }
     }
-    cout << "\n";
+    frame.line("");
     
     // 显示地图
-    if (fogModeEnabled && fogOfWar) {
-        displayMapWithFog();
+    if (session->getFogOfWar()) {
+        displayMapWithFog(frame);
     } else {
-        for (int y = 0; y < currentMap->getHeight(); y++) {
-            for (int x = 0; x < currentMap->getWidth(); x++) {
-                Position playerPos = player.getPosition();
+        Position playerPos = player.getPosition();
+        string rowText;
+        for (int y = 0; y < map.getHeight(); y++) {
+            const uint8_t* rowCells = map.row(y);
+            rowText.clear();
+            for (int x = 0; x < map.getWidth(); x++) {
                 
                 // 显示路径
-                bool isPath = false;
-                if (autoModeRunning && !currentPath.empty()) {
-                    for (size_t i = currentPathIndex; i < currentPath.size(); i++) {
-                        if (currentPath[i].x == x && currentPath[i].y == y) {
-                            cout << ". ";
-                            isPath = true;
-                            break;
-                        }
-                    }
+                if (autoModeRunning && session->isOnPath(x, y)) {
+                    rowText += ". ";
+                    continue;
                 }
                 
-                if (isPath) continue;
-                
                 if (x == playerPos.x && y == playerPos.y) {
-                    cout << "P ";
+                    rowText += "P ";
                 } else {
-                    CellType cell = currentMap->getCell(x, y);
+                    CellType cell = static_cast<CellType>(rowCells[x]);
                     switch (cell) {
-                        case EMPTY: cout << "  "; break;
-                        case WALL: cout << "# "; break;
-                        case TRAP: cout << "x "; break;
-                        case START: cout << "S "; break;
-                        case END: cout << "E "; break;
-                        default: cout << "? "; break;
+                        case EMPTY: rowText += "  "; break;
+                        case WALL: rowText += "# "; break;
+                        case TRAP: rowText += "x "; break;
+                        case START: rowText += "S "; break;
+                        case END: rowText += "E "; break;
+                        default: rowText += "? "; break;
                     }
                 }
             }
-            cout << endl;
+            frame.line(rowText);
         }
-        cout << endl;
+        frame.line("");
     }
     
     // 图例
-    cout << "图例: P=玩家, #=墙壁, x=陷阱, S=起点, E=终点";
+    string legend = "图例: P=玩家, #=墙壁, x=陷阱, S=起点, E=终点";
     if (autoModeRunning && !currentPath.empty()) {
-        cout << ", .=规划路径";
+        legend += ", .=规划路径";
     }
     if (fogModeEnabled) {
-        cout << ", ?=未探索区域";
+        legend += ", ?=未探索区域";
     }
-    cout << "\n";
+    frame.line(legend);
     
     if (autoModeEnabled && !currentPath.empty() && !autoModeRunning) {
-        cout << "找到路径! 长度: " << currentPath.size() << " 步\n";
+        text.str("");
+        text << "找到路径! 长度: " << currentPath.size() << " 步";
+        frame.line(text.str());
     }
     
-    cout << "----------------------------------------\n";
+    frame.line("----------------------------------------");
 }
 
-// 其他现有函数保持不变...
-void Game::displayMapWithFog() const {
-    // 保持原有实现，这里省略以节省空间
-    Position playerPos = player.getPosition();
-    
-    for (int y = 0; y < currentMap->getHeight(); y++) {
-        for (int x = 0; x < currentMap->getWidth(); x++) {
+void Game::displayMapWithFog(FrameRenderer& frame) const {
+    const Map& map = session->getMap();
+    const FogOfWar* fogOfWar = session->getFogOfWar();
+    Position playerPos = session->getPlayer().getPosition();
+    string rowText;
+    
+    for (int y = 0; y < map.getHeight(); y++) {
+        const uint8_t* rowCells = map.row(y);
+        rowText.clear();
+        for (int x = 0; x < map.getWidth(); x++) {
             FogState fogState = fogOfWar->getFogState(x, y);
             
             if (fogState == FOG_UNEXPLORED) {
-                cout << "? ";
+                rowText += "? ";
                 continue;
             }
             
             // 显示路径（在自动模式下）
-            bool isPath = false;
-            if (autoModeRunning && !currentPath.empty()) {
-                for (size_t i = currentPathIndex; i < currentPath.size(); i++) {
-                    if (currentPath[i].x == x && currentPath[i].y == y) {
-                        cout << ". ";
-                        isPath = true;
-                        break;
-                    }
-                }
+            if (autoModeRunning && session->isOnPath(x, y)) {
+                rowText += ". ";
+                continue;
             }
             
-            if (isPath) continue;
-            
             // 可见或已探索区域
             if (x == playerPos.x && y == playerPos.y) {
-                cout << "P ";
+                rowText += "P ";
             } else {
-                CellType cell = currentMap->getCell(x, y);
+                CellType cell = static_cast<CellType>(rowCells[x]);
                 switch (cell) {
                     case EMPTY: 
-                        cout << "  "; 
+                        rowText += "  "; 
                         break;
                     case WALL: 
-                        cout << "# "; 
+                        rowText += "# "; 
                         break;
                     case TRAP: 
-                        if (fogState == FOG_VISIBLE) {
-                            cout << "x ";
-                        } else {
-                            cout << "  ";
-                        }
+                        rowText += fogState == FOG_VISIBLE ? "x " : "  ";
                         break;
                     case START: 
-                        cout << "S "; 
+                        rowText += "S "; 
                         break;
                     case END: 
-                        if (fogState == FOG_VISIBLE) {
-                            cout << "E ";
-                        } else {
-                            cout << "  ";
-                        }
+                        rowText += fogState == FOG_VISIBLE ? "E " : "  ";
                         break;
                     default: 
-                        cout << "? "; 
+                        rowText += "? "; 
                         break;
                 }
             }
         }
-        cout << endl;
+        frame.line(rowText);
     }
-    cout << endl;
+    frame.line("");
 }
 
 void Game::showGameOver(bool won) const {
-    system(CLEAR_SCREEN);
+    const Player& player = session->getPlayer();
+    const vector<Position>& currentPath = session->getPath();
+    
+    clearScreen();
     if (won) {
         cout << "🎉 恭喜！你成功走出了迷宫！\n";
     } else {
@@ -502,8 +466,8 @@ void Game::showGameOver(bool won) const {
     cout << "总步数: " << player.getSteps() << "\n";
     cout << "剩余生命值: " << player.getHealth() << "\n";
     
-    if (fogModeEnabled && fogOfWar) {
-        cout << "最终探索进度: " << fogOfWar->getExploredPercent() << "%\n";
+    if (session->getFogOfWar()) {
+        cout << "最终探索进度: " << session->getFogOfWar()->getExploredPercent() << "%\n";
     }
     
     if (autoModeEnabled && !currentPath.empty()) {
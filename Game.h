@@ -3,35 +3,43 @@
 #define GAME_H
 
 #include "Map.h"
-#include "Player.h"
-#include "FogOfWar.h"
-#include "PathFinder.h"  // 新增include
+#include "GameSession.h"
+#include "FrameRenderer.h"
+#include "EventLoop.h"
+#include "Terminal.h"
 #include <vector>
 #include <memory>
-#include <thread>
-#include <atomic>
 
 class Game {
 private:
+    static constexpr int TICK_MS = 50;   // 模拟时钟周期（毫秒）
+    static constexpr int FRAME_MS = 33;  // 两帧之间的最短间隔（毫秒）
+    
     std::vector<Map> maps;
-    Player player;
     Map* currentMap;
     bool gameRunning;
-    std::unique_ptr<FogOfWar> fogOfWar;
     bool fogModeEnabled;
-    
-    // 自动模式相关
-    std::unique_ptr<PathFinder> pathFinder;
-    std::vector<Position> currentPath;
-    size_t currentPathIndex;
+    VisionMode visionMode;  // 迷雾模式下的视野：圆形或视线遮挡
     bool autoModeEnabled;
-    std::atomic<bool> autoModeRunning;
-    std::thread autoModeThread;
-    int autoMoveDelay;  // 自动移动延迟（毫秒）
+    
+    // 当前对局（规则状态），界面只负责输入和显示
+    std::unique_ptr<GameSession> session;
+    
+    // 游戏画面的差量渲染器
+    FrameRenderer renderer;
+    
+    // 标准输入的按键缓冲（对局和“按任意键继续”共用）
+    KeyReader keys;
+    
+    // 自动模式相关（由事件循环的时钟驱动，与输入、渲染在同一线程）
+    bool autoModeRunning;
+    bool autoModeBlocked;  // 后台规划结束仍找不到路径
+    int autoMoveDelay;     // 自动移动延迟（毫秒）
+    int ticksSinceMove;
     
 public:
     Game();
-    ~Game();  // 需要析构函数来管理线程
+    ~Game();
     
     void run();
     
@@ -41,17 +49,18 @@ private:
     void toggleFogMode();
     void toggleAutoMode();  // 新增：切换自动模式
     void playGame();
-    void displayGameState() const;
-    void displayMapWithFog() const;
+    void displayGameState(FrameRenderer& frame) const;
+    void displayMapWithFog(FrameRenderer& frame) const;
     void showGameOver(bool won) const;
     
+    // 终端辅助
+    static void clearScreen();
+    void waitForKey();
+    
     // 自动模式功能
     void startAutoMode();
     void stopAutoMode();
-    void autoModeWorker();
-    bool calculatePath();
-    void performAutoMove();
-    void displayPath() const;
+    bool updateAutoMode(int ticks);  // 推进 ticks 个时钟周期，画面需要重绘时返回 true
 };
 
-#endif
\ No newline at end of file
+#endif
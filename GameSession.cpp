@@ -0,0 +1,225 @@
+// GameSession.cpp
+#include "GameSession.h"
+
+using namespace std;
+
+GameSession::GameSession(const Map& templateMap, bool fogMode, bool autoMode,
+                         VisionMode visionMode, int visionRange, int maxHealth)
+    : map(templateMap), status(GAME_RUNNING), autoMode(autoMode), currentPathIndex(0),
+      pathStep(static_cast<size_t>(templateMap.getWidth()) * templateMap.getHeight(), -1),
+      planVersion(0), planEpsilon(1.0) {
+    // 初始化玩家位置
+    Position startPos = map.getStartPosition();
+    player = Player(startPos.x, startPos.y, maxHealth);
+    
+    // 初始化系统
+    if (fogMode) {
+        fogOfWar = make_unique<FogOfWar>(map.getWidth(), map.getHeight(), visionRange);
+        fogOfWar->setVisionMode(visionMode, &map);
+        fogOfWar->updateVisibility(player.getPosition());
+    }
+}
+
+PathFinder* GameSession::ensurePathFinder() {
+    // 交互模式走后台规划，不调用同步接口，也就不必建立和维护距离场
+    if (!pathFinder && autoMode) {
+        // 同步自动模式沿终点距离场行走：陷阱格成本更高，地图变化后距离场只做局部更新
+        pathFinder = make_unique<PathFinder>(&map);
+        pathFinder->setSearchMode(SEARCH_DISTANCE_FIELD);
+        pathFinder->setTrapCost(TRAP_PATH_COST);
+    }
+    return pathFinder.get();
+}
+
+int GameSession::applyMove(char direction) {
+    if (status != GAME_RUNNING) {
+        return EVENT_NONE;
+    }
+    
+    if (!player.move(direction, map)) {
+        return EVENT_BLOCKED;
+    }
+    
+    int events = EVENT_MOVED;
+    Position playerPos = player.getPosition();
+    CellType currentCell = map.getCell(playerPos.x, playerPos.y);
+    
+    // 更新迷雾视野
+    if (fogOfWar) {
+        fogOfWar->updateVisibility(playerPos);
+    }
+    
+    // 检查陷阱，陷阱触发后消失
+    if (currentCell == TRAP) {
+        player.takeDamage(TRAP_DAMAGE);
+        map.setCell(playerPos.x, playerPos.y, EMPTY);
+        events |= EVENT_TRAP;
+        if (!player.isAlive()) {
+            status = GAME_LOST;
+            events |= EVENT_DIED;
+        }
+    }
+    
+    // 检查是否到达终点
+    if (currentCell == END) {
+        status = GAME_WON;
+        events |= EVENT_WON;
+    }
+    
+    return events;
+}
+
+bool GameSession::planPath() {
+    if (!ensurePathFinder()) return false;
+    
+    // 规划的路径不能让玩家在途中因陷阱死亡
+    pathFinder->setHealthBudget(player.getHealth(), TRAP_DAMAGE);
+    
+    clearPathOverlay();
+    
+    // 复用 currentPath 的容量，重复规划时不产生堆分配
+    bool found = pathFinder->findPath(player.getPosition(), map.getEndPosition(), currentPath);
+    currentPathIndex = 1;  // 路径的第一个点是玩家当前位置
+    planEpsilon = 1.0;
+    rebuildPathOverlay();
+    
+    return found;
+}
+
+int GameSession::maxTrapsForHealth() const {
+    // 与 PathFinder::setHealthBudget 相同：踩中的陷阱不得使生命值降到0
+    return player.getHealth() > 0 ? (player.getHealth() - 1) / TRAP_DAMAGE : 0;
+}
+
+shared_future<PlanResult> GameSession::planPathAsync() {
+    if (!asyncPlanner) {
+        asyncPlanner = make_unique<AsyncPlanner>();
+    }
+    return asyncPlanner->start(map, player.getPosition(), map.getEndPosition(),
+                               TRAP_PATH_COST, maxTrapsForHealth());
+}
+
+void GameSession::cancelPlanning() {
+    if (asyncPlanner) {
+        asyncPlanner->cancel();
+    }
+}
+
+bool GameSession::pollPlan() {
+    double epsilon;
+    if (!asyncPlanner || !asyncPlanner->fetch(planVersion, planBuffer, epsilon)) {
+        return false;
+    }
+    
+    // 新路径从规划开始时的位置出发，玩家可能已经沿旧路径走了几步
+    Position pos = player.getPosition();
+    size_t index = 0;
+    while (index < planBuffer.size() && !(planBuffer[index] == pos)) {
+        index++;
+    }
+    if (index == planBuffer.size()) {
+        return false;  // 已偏离新路径，继续沿旧路径走
+    }
+    
+    // 剩余部分的陷阱不能超出当前的生命值预算（玩家实际走过的前缀可能踩了不同的陷阱）
+    int traps = 0;
+    for (size_t i = index + 1; i < planBuffer.size(); i++) {
+        traps += map.getCell(planBuffer[i].x, planBuffer[i].y) == TRAP;
+    }
+    if (traps > maxTrapsForHealth()) {
+        return false;
+    }
+    
+    clearPathOverlay();
+    currentPath.swap(planBuffer);
+    currentPathIndex = index + 1;
+    planEpsilon = epsilon;
+    rebuildPathOverlay();
+    return true;
+}
+
+int GameSession::stepAlongPath() {
+    if (status != GAME_RUNNING || currentPathIndex >= currentPath.size()) {
+        return EVENT_NONE;
+    }
+    
+    Position pos = player.getPosition();
+    Position next = currentPath[currentPathIndex];
+    char direction = ' ';
+    if (next.x == pos.x && next.y == pos.y - 1) direction = 'w';
+    else if (next.x == pos.x && next.y == pos.y + 1) direction = 's';
+    else if (next.x == pos.x - 1 && next.y == pos.y) direction = 'a';
+    else if (next.x == pos.x + 1 && next.y == pos.y) direction = 'd';
+    
+    int events = direction == ' ' ? EVENT_BLOCKED : applyMove(direction);
+    if (events & EVENT_MOVED) {
+        // 踩中陷阱不需要重新规划：剩余路径本来就在扣除这个陷阱后的预算之内
+        setPathIndex(currentPathIndex + 1);
+        return events;
+    }
+    
+    // 走不通：丢弃当前路径，从当前位置重新规划
+    clearPathOverlay();
+    currentPath.clear();
+    currentPathIndex = 0;
+    planPathAsync();
+    return EVENT_NONE;
+}
+
+int GameSession::getRemainingPathCost() const {
+    if (currentPath.empty()) {
+        return -1;
+    }
+    int cost = 0;
+    for (size_t i = currentPathIndex; i < currentPath.size(); i++) {
+        cost += map.getCell(currentPath[i].x, currentPath[i].y) == TRAP ? TRAP_PATH_COST : 1;
+    }
+    return cost;
+}
+
+void GameSession::clearPathOverlay() {
+    // 只改动旧路径经过的格子
+    for (const Position& pos : currentPath) {
+        pathStep[static_cast<size_t>(pos.y) * map.getWidth() + pos.x] = -1;
+    }
+}
+
+void GameSession::rebuildPathOverlay() {
+    for (size_t i = 0; i < currentPath.size(); i++) {
+        const Position& pos = currentPath[i];
+        pathStep[static_cast<size_t>(pos.y) * map.getWidth() + pos.x] = static_cast<int>(i);
+    }
+}
+
+void GameSession::setPathIndex(size_t index) {
+    // 走过的格子移出覆盖层；isOnPath 按步号比较，这里只是保持覆盖层干净
+    if (currentPathIndex > 0 && currentPathIndex <= currentPath.size()) {
+        const Position& passed = currentPath[currentPathIndex - 1];
+        pathStep[static_cast<size_t>(passed.y) * map.getWidth() + passed.x] = -1;
+    }
+    currentPathIndex = index;
+}
+
+int GameSession::stepAuto() {
+    if (status != GAME_RUNNING || !ensurePathFinder()) {
+        return EVENT_NONE;
+    }
+    
+    // 沿距离场走向到终点代价最小的邻居，每步 O(1)
+    char direction = pathFinder->getNextMoveToGoal(player.getPosition());
+    int events = applyMove(direction);
+    
+    if (events & EVENT_TRAP) {
+        // 地图和生命值预算都变了：距离场局部更新，顺带刷新显示的路径
+        if (status == GAME_RUNNING && !planPath()) {
+            events |= EVENT_BLOCKED;
+        }
+    } else if (events & EVENT_MOVED) {
+        setPathIndex(currentPathIndex + 1);
+    } else {
+        // 移动失败：重新规划，仍然找不到路径才算受阻
+        events = planPath() ? EVENT_NONE : EVENT_BLOCKED;
+    }
+    
+    return events;
+}
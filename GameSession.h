@@ -0,0 +1,121 @@
+// GameSession.h
+#ifndef GAMESESSION_H
+#define GAMESESSION_H
+
+#include "Map.h"
+#include "Player.h"
+#include "FogOfWar.h"
+#include "PathFinder.h"
+#include "AsyncPlanner.h"
+#include <vector>
+#include <memory>
+#include <future>
+#include <cstdint>
+
+// 对局状态
+enum GameStatus {
+    GAME_RUNNING = 0,
+    GAME_WON = 1,
+    GAME_LOST = 2
+};
+
+// 单步事件（可按位组合）
+enum GameEvent {
+    EVENT_NONE = 0,
+    EVENT_MOVED = 1,     // 成功移动
+    EVENT_BLOCKED = 2,   // 移动失败或无路可走
+    EVENT_TRAP = 4,      // 踩中陷阱
+    EVENT_WON = 8,       // 到达终点
+    EVENT_DIED = 16      // 生命值耗尽
+};
+
+// 一局游戏的规则：移动、陷阱、迷雾、自动寻路、胜负判定
+// 不做任何终端输入输出，交互式的 Game 和无界面的模拟器共用同一套规则。
+// 每局复制一份地图，陷阱被消耗不会影响预设地图。
+class GameSession {
+public:
+    static const int TRAP_DAMAGE = 30;     // 踩中陷阱损失的生命值
+    static const int TRAP_PATH_COST = 10;  // 自动寻路时陷阱格的成本（普通格为1）
+    
+private:
+    Map map;
+    Player player;
+    GameStatus status;
+    std::unique_ptr<FogOfWar> fogOfWar;
+    
+    // 自动模式相关
+    bool autoMode;
+    std::unique_ptr<PathFinder> pathFinder;  // 同步寻路（距离场），第一次调用 planPath/stepAuto 时创建
+    std::vector<Position> currentPath;
+    size_t currentPathIndex;
+    
+    // 路径覆盖层：每个格子在 currentPath 中的步号，不在路径上为 -1
+    // 渲染时每格 O(1) 判断，前进一步只改动一个格子
+    std::vector<int> pathStep;
+    
+    // 后台规划（交互模式使用）：先发布次优路径，之后逐步改进
+    std::unique_ptr<AsyncPlanner> asyncPlanner;
+    uint64_t planVersion;
+    double planEpsilon;  // currentPath 的次优上界，1 表示最优
+    std::vector<Position> planBuffer;
+    
+public:
+    GameSession(const Map& templateMap, bool fogMode, bool autoMode,
+                VisionMode visionMode = VISION_RADIUS, int visionRange = 2, int maxHealth = 100);
+    
+    // 地图和寻路器之间有指针关联，不允许复制
+    GameSession(const GameSession&) = delete;
+    GameSession& operator=(const GameSession&) = delete;
+    
+    // 手动移动一步（WASD），返回事件
+    int applyMove(char direction);
+    
+    // 自动模式（同步，供无界面模拟使用）：从当前位置规划到终点的路径
+    bool planPath();
+    
+    // 自动模式（同步，供无界面模拟使用）：沿距离场走一步，返回事件；无路可走时返回 EVENT_BLOCKED
+    int stepAuto();
+    
+    // 自动模式的后台规划：复制地图快照交给后台线程运行 ARA* 后立即返回，
+    // 规划出的路径（先次优、后逐步改进）通过 pollPlan() 取用；之前未完成的规划会被取消
+    std::shared_future<PlanResult> planPathAsync();
+    void cancelPlanning();
+    bool isPlanning() const { return asyncPlanner && asyncPlanner->isRunning(); }
+    
+    // 取用后台新发布的路径；玩家已偏离新路径或剩余部分超出生命值预算时不采用
+    // currentPath 被更新时返回 true
+    bool pollPlan();
+    
+    // 自动模式：沿 currentPath 走一步，返回事件
+    // 路径走不通时清空路径并重新开始后台规划，返回 EVENT_NONE
+    int stepAlongPath();
+    
+    // 状态获取
+    GameStatus getStatus() const { return status; }
+    bool isOver() const { return status != GAME_RUNNING; }
+    const Map& getMap() const { return map; }
+    const Player& getPlayer() const { return player; }
+    const FogOfWar* getFogOfWar() const { return fogOfWar.get(); }
+    const PathFinder* getPathFinder() const { return pathFinder.get(); }
+    const std::vector<Position>& getPath() const { return currentPath; }
+    size_t getPathIndex() const { return currentPathIndex; }
+    bool hasPath() const { return !currentPath.empty(); }
+    double getPlanEpsilon() const { return planEpsilon; }
+    
+    // 沿 currentPath 剩余部分走到终点的代价（陷阱格按 TRAP_PATH_COST 计），没有路径时返回 -1
+    int getRemainingPathCost() const;
+    
+    // (x, y) 是否在尚未走过的规划路径上
+    bool isOnPath(int x, int y) const {
+        return pathStep[static_cast<size_t>(y) * map.getWidth() + x] >= static_cast<int>(currentPathIndex);
+    }
+    
+private:
+    void setPathIndex(size_t index);
+    void rebuildPathOverlay();
+    void clearPathOverlay();
+    int maxTrapsForHealth() const;
+    PathFinder* ensurePathFinder();
+};
+
+#endif
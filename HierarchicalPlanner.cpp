@@ -0,0 +1,424 @@
+// HierarchicalPlanner.cpp
+#include "HierarchicalPlanner.h"
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+
+using namespace std;
+
+HierarchicalPlanner::HierarchicalPlanner(const Map* map)
+    : map(map), trapCost(1), built(false), syncedRevision(0), clustersX(0), clustersY(0),
+      expandedCount(0), rebuiltClusters(0) {}
+
+void HierarchicalPlanner::setTrapCost(int cost) {
+    cost = max(1, min(cost, 1000));
+    if (cost != trapCost) {
+        trapCost = cost;
+        built = false;  // 所有簇内代价都变了，整体重建
+    }
+}
+
+bool HierarchicalPlanner::plan(const Position& start, const Position& goal, vector<Position>& path) {
+    path.clear();
+    expandedCount = 0;
+
+    if (map->getCell(start.x, start.y) == WALL || map->getCell(goal.x, goal.y) == WALL) {
+        return false;
+    }
+
+    if (!built || !syncMapChanges()) {
+        buildAll();
+    }
+    expandedCount = 0;
+
+    if (!map->isReachable(start, goal)) {
+        return false;
+    }
+
+    int startCell = map->cellIndex(start.x, start.y);
+    int goalCell = map->cellIndex(goal.x, goal.y);
+    if (startCell == goalCell) {
+        path.push_back(start);
+        return true;
+    }
+
+    // 临时接入起点：起点到所在簇各节点的代价，同簇时顺带得到直达终点的代价
+    const Cluster& startCluster = clusters[clusterOf(startCell)];
+    searchCluster(startCluster, startCell, -1, false);
+    startDist.resize(startCluster.nodeCount);
+    for (int i = 0; i < startCluster.nodeCount; i++) {
+        startDist[i] = localDist[localIndex(startCluster, startCluster.cells[i])];
+    }
+    int directCost = contains(startCluster, goalCell) ? localDist[localIndex(startCluster, goalCell)] : INF;
+
+    // 临时接入终点：反向搜索得到终点簇各节点到终点的代价
+    const Cluster& goalCluster = clusters[clusterOf(goalCell)];
+    searchCluster(goalCluster, goalCell, -1, true);
+    goalDist.resize(goalCluster.nodeCount);
+    for (int i = 0; i < goalCluster.nodeCount; i++) {
+        goalDist[i] = localDist[localIndex(goalCluster, goalCluster.cells[i])];
+    }
+
+    if (!searchAbstract(startCell, goalCell, directCost)) {
+        return false;
+    }
+
+    // 逐段细化：跨簇的边只有一步，簇内的边在该簇内重新搜索
+    const int startId = static_cast<int>(clusters.size()) * MAX_CLUSTER_NODES;
+    const int goalId = startId + 1;
+    auto cellOf = [&](int id) {
+        if (id == startId) return startCell;
+        if (id == goalId) return goalCell;
+        return clusters[id / MAX_CLUSTER_NODES].cells[id % MAX_CLUSTER_NODES];
+    };
+
+    path.push_back(start);
+    for (size_t i = 1; i < abstractPath.size(); i++) {
+        int from = cellOf(abstractPath[i - 1]);
+        int to = cellOf(abstractPath[i]);
+        if (from == to) {
+            continue;
+        }
+        int fromCluster = clusterOf(from);
+        if (fromCluster != clusterOf(to)) {
+            path.push_back(map->indexToPosition(to));
+        } else {
+            refineSegment(clusters[fromCluster], from, to, path);
+        }
+    }
+    return true;
+}
+
+void HierarchicalPlanner::buildAll() {
+    int width = map->getWidth();
+    int height = map->getHeight();
+    clustersX = (width + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+    clustersY = (height + CLUSTER_SIZE - 1) / CLUSTER_SIZE;
+
+    clusters.assign(clustersX * clustersY, Cluster());
+    dirty.assign(clusters.size(), 0);
+    dirtyList.clear();
+    localDist.assign(CLUSTER_SIZE * CLUSTER_SIZE, INF);
+    localParent.assign(CLUSTER_SIZE * CLUSTER_SIZE, -1);
+
+    for (int cy = 0; cy < clustersY; cy++) {
+        for (int cx = 0; cx < clustersX; cx++) {
+            Cluster& cluster = clusters[cy * clustersX + cx];
+            cluster.x0 = cx * CLUSTER_SIZE;
+            cluster.y0 = cy * CLUSTER_SIZE;
+            cluster.width = min(CLUSTER_SIZE, width - cluster.x0);
+            cluster.height = min(CLUSTER_SIZE, height - cluster.y0);
+            rebuildCluster(cy * clustersX + cx);
+        }
+    }
+
+    rebuiltClusters = static_cast<int>(clusters.size());
+    syncedRevision = map->getRevision();
+    built = true;
+}
+
+bool HierarchicalPlanner::syncMapChanges() {
+    rebuiltClusters = 0;
+    if (map->getRevision() == syncedRevision) {
+        return true;
+    }
+    if (!map->getChangesSince(syncedRevision, changes)) {
+        return false;
+    }
+    syncedRevision = map->getRevision();
+
+    // 入口只取决于边界两侧的两行格子，簇内代价只取决于簇内格子：
+    // 变化格子所在的簇必须重建，格子位于簇边缘时对面的簇的入口也随之改变
+    for (const CellChange& change : changes) {
+        int cx = change.x / CLUSTER_SIZE;
+        int cy = change.y / CLUSTER_SIZE;
+        markDirty(cx, cy);
+        if (change.x % CLUSTER_SIZE == 0) markDirty(cx - 1, cy);
+        if (change.x % CLUSTER_SIZE == CLUSTER_SIZE - 1) markDirty(cx + 1, cy);
+        if (change.y % CLUSTER_SIZE == 0) markDirty(cx, cy - 1);
+        if (change.y % CLUSTER_SIZE == CLUSTER_SIZE - 1) markDirty(cx, cy + 1);
+    }
+
+    for (int id : dirtyList) {
+        rebuildCluster(id);
+        dirty[id] = 0;
+    }
+    rebuiltClusters = static_cast<int>(dirtyList.size());
+    dirtyList.clear();
+    return true;
+}
+
+void HierarchicalPlanner::markDirty(int cx, int cy) {
+    if (cx < 0 || cy < 0 || cx >= clustersX || cy >= clustersY) {
+        return;
+    }
+    int id = cy * clustersX + cx;
+    if (!dirty[id]) {
+        dirty[id] = 1;
+        dirtyList.push_back(id);
+    }
+}
+
+void HierarchicalPlanner::rebuildCluster(int id) {
+    Cluster& cluster = clusters[id];
+    cluster.nodeCount = 0;
+    for (int direction = 0; direction < 4; direction++) {
+        addEntrances(cluster, direction);
+    }
+
+    // 从每个节点做一次簇内 Dijkstra，得到到其余节点的代价
+    int n = cluster.nodeCount;
+    cluster.dist.assign(n * n, INF);
+    for (int i = 0; i < n; i++) {
+        searchCluster(cluster, cluster.cells[i], -1, false);
+        for (int j = 0; j < n; j++) {
+            cluster.dist[i * n + j] = localDist[localIndex(cluster, cluster.cells[j])];
+        }
+    }
+}
+
+void HierarchicalPlanner::addEntrances(Cluster& cluster, int direction) {
+    const int stride = map->getStride();
+    const uint8_t* cells = map->data();
+
+    // 本侧边界线的第一个格子、沿边界前进的步长、到对面格子的偏移
+    int first, step, across, length;
+    switch (direction) {
+        case 0:  // 上
+            if (cluster.y0 == 0) return;
+            first = map->cellIndex(cluster.x0, cluster.y0);
+            step = 1; across = -stride; length = cluster.width;
+            break;
+        case 1:  // 右
+            if (cluster.x0 + cluster.width >= map->getWidth()) return;
+            first = map->cellIndex(cluster.x0 + cluster.width - 1, cluster.y0);
+            step = stride; across = 1; length = cluster.height;
+            break;
+        case 2:  // 下
+            if (cluster.y0 + cluster.height >= map->getHeight()) return;
+            first = map->cellIndex(cluster.x0, cluster.y0 + cluster.height - 1);
+            step = 1; across = stride; length = cluster.width;
+            break;
+        default:  // 左
+            if (cluster.x0 == 0) return;
+            first = map->cellIndex(cluster.x0, cluster.y0);
+            step = stride; across = -1; length = cluster.height;
+            break;
+    }
+
+    // 两侧都可通行的连续段为一个入口；两侧的簇扫描的是同一对格子，得到的入口位置一致
+    int runStart = -1;
+    for (int i = 0; i <= length; i++) {
+        int cell = first + i * step;
+        bool open = i < length && cells[cell] != WALL && cells[cell + across] != WALL;
+        if (open) {
+            if (runStart < 0) runStart = i;
+            continue;
+        }
+        if (runStart < 0) {
+            continue;
+        }
+        int runLength = i - runStart;
+        if (runLength < LONG_ENTRANCE) {
+            addNode(cluster, first + (runStart + runLength / 2) * step, direction);
+        } else {
+            addNode(cluster, first + runStart * step, direction);
+            addNode(cluster, first + (i - 1) * step, direction);
+        }
+        runStart = -1;
+    }
+}
+
+void HierarchicalPlanner::addNode(Cluster& cluster, int cell, int direction) {
+    // 簇角上的格子可能同时是两条边界的入口，合并为一个节点
+    int node = findNode(cluster, cell);
+    if (node < 0) {
+        node = cluster.nodeCount++;
+        cluster.cells[node] = cell;
+        cluster.crossMask[node] = 0;
+    }
+    cluster.crossMask[node] |= static_cast<uint8_t>(1 << direction);
+}
+
+int HierarchicalPlanner::clusterOf(int cell) const {
+    Position pos = map->indexToPosition(cell);
+    return (pos.y / CLUSTER_SIZE) * clustersX + pos.x / CLUSTER_SIZE;
+}
+
+int HierarchicalPlanner::findNode(const Cluster& cluster, int cell) const {
+    for (int i = 0; i < cluster.nodeCount; i++) {
+        if (cluster.cells[i] == cell) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+bool HierarchicalPlanner::contains(const Cluster& cluster, int cell) const {
+    Position pos = map->indexToPosition(cell);
+    return pos.x >= cluster.x0 && pos.x < cluster.x0 + cluster.width &&
+           pos.y >= cluster.y0 && pos.y < cluster.y0 + cluster.height;
+}
+
+int HierarchicalPlanner::localIndex(const Cluster& cluster, int cell) const {
+    Position pos = map->indexToPosition(cell);
+    return (pos.y - cluster.y0) * CLUSTER_SIZE + (pos.x - cluster.x0);
+}
+
+int HierarchicalPlanner::enterCost(int index) const {
+    uint8_t type = map->data()[index];
+    if (type == WALL) return INF;
+    if (type == TRAP) return trapCost;
+    return 1;
+}
+
+void HierarchicalPlanner::searchCluster(const Cluster& cluster, int source, int target, bool reverse) {
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    const uint8_t* cells = map->data();
+
+    fill(localDist.begin(), localDist.end(), INF);
+    localHeap.clear();
+
+    int sourceLocal = localIndex(cluster, source);
+    localDist[sourceLocal] = 0;
+    localParent[sourceLocal] = -1;
+    localHeap.push_back(make_pair(0, source));
+
+    while (!localHeap.empty()) {
+        pop_heap(localHeap.begin(), localHeap.end(), greater<pair<int, int>>());
+        int cost = localHeap.back().first;
+        int cell = localHeap.back().second;
+        localHeap.pop_back();
+
+        if (cost > localDist[localIndex(cluster, cell)]) {
+            continue;
+        }
+        expandedCount++;
+        if (cell == target) {
+            return;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            int next = cell + offsets[i];
+            if (cells[next] == WALL || !contains(cluster, next)) {
+                continue;
+            }
+            // 反向搜索时代价是从 next 走进 cell 的成本
+            int newCost = cost + (reverse ? enterCost(cell) : enterCost(next));
+            int nextLocal = localIndex(cluster, next);
+            if (newCost < localDist[nextLocal]) {
+                localDist[nextLocal] = newCost;
+                localParent[nextLocal] = cell;
+                localHeap.push_back(make_pair(newCost, next));
+                push_heap(localHeap.begin(), localHeap.end(), greater<pair<int, int>>());
+            }
+        }
+    }
+}
+
+bool HierarchicalPlanner::searchAbstract(int startCell, int goalCell, int directCost) {
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    const int startId = static_cast<int>(clusters.size()) * MAX_CLUSTER_NODES;
+    const int goalId = startId + 1;
+    const int startClusterId = clusterOf(startCell);
+    const int goalClusterId = clusterOf(goalCell);
+    const Position goalPos = map->indexToPosition(goalCell);
+
+    SearchContext& ctx = abstractSearch;
+    ctx.prepare(goalId + 1);
+
+    auto heuristic = [&](int cell) {
+        Position pos = map->indexToPosition(cell);
+        return abs(pos.x - goalPos.x) + abs(pos.y - goalPos.y);
+    };
+    auto relax = [&](const Node& from, int id, int cell, int cost) {
+        int newGCost = from.gCost + cost;
+        if (!ctx.isVisited(id) || newGCost < ctx.gCost[id]) {
+            ctx.visit(id, newGCost, from.index);
+            ctx.push(Node(id, newGCost, heuristic(cell)));
+        }
+    };
+
+    ctx.visit(startId, 0, -1);
+    ctx.push(Node(startId, 0, heuristic(startCell)));
+
+    while (!ctx.empty()) {
+        Node current = ctx.pop();
+        if (current.gCost > ctx.gCost[current.index]) {
+            continue;
+        }
+        expandedCount++;
+
+        if (current.index == goalId) {
+            abstractPath.clear();
+            for (int id = goalId; id != -1; id = ctx.parent[id]) {
+                abstractPath.push_back(id);
+            }
+            reverse(abstractPath.begin(), abstractPath.end());
+            return true;
+        }
+
+        if (current.index == startId) {
+            const Cluster& cluster = clusters[startClusterId];
+            for (int i = 0; i < cluster.nodeCount; i++) {
+                if (startDist[i] < INF) {
+                    relax(current, startClusterId * MAX_CLUSTER_NODES + i, cluster.cells[i], startDist[i]);
+                }
+            }
+            if (directCost < INF) {
+                relax(current, goalId, goalCell, directCost);
+            }
+            continue;
+        }
+
+        int clusterId = current.index / MAX_CLUSTER_NODES;
+        int node = current.index % MAX_CLUSTER_NODES;
+        const Cluster& cluster = clusters[clusterId];
+        int n = cluster.nodeCount;
+
+        // 簇内的边
+        for (int i = 0; i < n; i++) {
+            int cost = cluster.dist[node * n + i];
+            if (i != node && cost < INF) {
+                relax(current, clusterId * MAX_CLUSTER_NODES + i, cluster.cells[i], cost);
+            }
+        }
+
+        // 跨簇的边：入口另一侧的格子
+        for (int direction = 0; direction < 4; direction++) {
+            if (!(cluster.crossMask[node] & (1 << direction))) {
+                continue;
+            }
+            int next = cluster.cells[node] + offsets[direction];
+            int nextCluster = clusterOf(next);
+            int nextNode = findNode(clusters[nextCluster], next);
+            if (nextNode >= 0) {
+                relax(current, nextCluster * MAX_CLUSTER_NODES + nextNode, next, enterCost(next));
+            }
+        }
+
+        // 终点簇内的节点可直接走到终点
+        if (clusterId == goalClusterId && goalDist[node] < INF) {
+            relax(current, goalId, goalCell, goalDist[node]);
+        }
+    }
+
+    return false;
+}
+
+void HierarchicalPlanner::refineSegment(const Cluster& cluster, int from, int to, vector<Position>& path) {
+    searchCluster(cluster, from, to, false);
+    if (localDist[localIndex(cluster, to)] >= INF) {
+        return;  // 抽象边来自同一份簇内代价，理论上不会发生
+    }
+
+    segment.clear();
+    for (int cell = to; cell != from; cell = localParent[localIndex(cluster, cell)]) {
+        segment.push_back(cell);
+    }
+    for (auto it = segment.rbegin(); it != segment.rend(); ++it) {
+        path.push_back(map->indexToPosition(*it));
+    }
+}
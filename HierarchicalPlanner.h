@@ -0,0 +1,112 @@
+// HierarchicalPlanner.h
+#ifndef HIERARCHICALPLANNER_H
+#define HIERARCHICALPLANNER_H
+
+#include "Map.h"
+#include "Position.h"
+#include "SearchContext.h"
+#include <vector>
+#include <utility>
+#include <cstdint>
+
+// 分层路径规划（HPA*）
+// 地图按 CLUSTER_SIZE x CLUSTER_SIZE 划分为簇。相邻两簇公共边界上两侧都可通行的连续段构成入口
+// （短段取中点，长段取两端），入口两侧的格子作为抽象图的节点，并预先计算每个簇内节点两两之间的代价。
+// 查询时把起点、终点临时接入所在的簇，先在抽象图上搜索，再只在选中的簇内逐段细化为逐格路径，
+// 因此长距离查询的开销主要取决于路径经过的簇数，而不是地图面积。
+// 地图变化通过 Map 的修改日志同步：只重建变化格子所在的簇（格子位于簇边缘时连同对面的簇）。
+// 进入普通格的成本为1，进入陷阱格的成本为 trapCost；得到的是近似最优路径。
+class HierarchicalPlanner {
+public:
+    static constexpr int CLUSTER_SIZE = 16;
+    static constexpr int INF = 0x3FFFFFFF;
+
+private:
+    // 每条边界最多 CLUSTER_SIZE / 2 个入口，四条边界合计不超过 2 * CLUSTER_SIZE 个节点
+    static constexpr int MAX_CLUSTER_NODES = 2 * CLUSTER_SIZE;
+    // 入口段长度达到该值时在两端各放一个节点
+    static constexpr int LONG_ENTRANCE = 6;
+
+    // 相邻入口之间至少隔一个不通的格子：短段每 2 格最多 1 个节点，长段每 LONG_ENTRANCE + 1 格 2 个节点，
+    // LONG_ENTRANCE >= 3 时每条边界最多 (CLUSTER_SIZE + 1) / 2 个节点。addNode 不检查容量，改动常量时由这里把关
+    static_assert(LONG_ENTRANCE >= 3, "长入口的两个节点会比短入口更密，簇节点数的上界不再成立");
+    static_assert(MAX_CLUSTER_NODES >= 4 * ((CLUSTER_SIZE + 1) / 2), "MAX_CLUSTER_NODES 放不下四条边界的全部入口");
+
+    struct Cluster {
+        int x0, y0, width, height;
+        int nodeCount;
+        int cells[MAX_CLUSTER_NODES];          // 节点所在格子的线性下标
+        uint8_t crossMask[MAX_CLUSTER_NODES];  // 通往相邻簇的边，按 上、右、下、左 各占一位
+        std::vector<int> dist;                 // nodeCount * nodeCount，簇内节点之间的代价（有向）
+    };
+
+    const Map* map;
+    int trapCost;
+    bool built;
+    uint64_t syncedRevision;
+    int clustersX, clustersY;
+    int expandedCount;
+    int rebuiltClusters;
+
+    std::vector<Cluster> clusters;
+    std::vector<uint8_t> dirty;
+    std::vector<int> dirtyList;
+    std::vector<CellChange> changes;
+
+    // 抽象图搜索：节点编号 = 簇号 * MAX_CLUSTER_NODES + 簇内序号，最后两个编号是临时接入的起点和终点
+    SearchContext abstractSearch;
+    std::vector<int> abstractPath;
+    std::vector<int> startDist;   // 起点到起点簇各节点的代价
+    std::vector<int> goalDist;    // 终点簇各节点到终点的代价
+
+    // 簇内 Dijkstra 的状态（按簇内坐标编号）
+    std::vector<int> localDist;
+    std::vector<int> localParent;
+    std::vector<std::pair<int, int>> localHeap;
+    std::vector<int> segment;
+
+public:
+    HierarchicalPlanner(const Map* map);
+
+    void setTrapCost(int cost);
+
+    // 规划从 start 到 goal 的路径（包含两端），找到路径返回 true
+    bool plan(const Position& start, const Position& goal, std::vector<Position>& path);
+
+    // 丢弃簇抽象，下次规划时整体重建
+    void reset() { built = false; }
+
+    // 最近一次规划扩展的节点数（抽象图节点与簇内细化的格子合计）
+    int getLastExpandedCount() const { return expandedCount; }
+
+    // 最近一次同步重建的簇数（整体构建时为全部簇）
+    int getRebuiltClusterCount() const { return rebuiltClusters; }
+
+private:
+    void buildAll();
+    bool syncMapChanges();
+    void markDirty(int cx, int cy);
+    void rebuildCluster(int id);
+
+    // 扫描簇在 direction 方向上的公共边界，为本侧的入口格子添加节点
+    void addEntrances(Cluster& cluster, int direction);
+    void addNode(Cluster& cluster, int cell, int direction);
+
+    int clusterOf(int cell) const;
+    int findNode(const Cluster& cluster, int cell) const;
+    bool contains(const Cluster& cluster, int cell) const;
+    int localIndex(const Cluster& cluster, int cell) const;
+    int enterCost(int index) const;
+
+    // 簇内 Dijkstra：求 source 到簇内各格的代价（reverse 时为各格到 source 的代价），
+    // target >= 0 时到达即停止
+    void searchCluster(const Cluster& cluster, int source, int target, bool reverse);
+
+    // 抽象图上的 A*，成功时 abstractPath 中保存节点序列
+    bool searchAbstract(int startCell, int goalCell, int directCost);
+
+    // 在簇内把 from 到 to 细化为逐格路径，追加到 path（不含 from）
+    void refineSegment(const Cluster& cluster, int from, int to, std::vector<Position>& path);
+};
+
+#endif
@@ -0,0 +1,259 @@
+// IncrementalPlanner.cpp
+#include "IncrementalPlanner.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace std;
+
+IncrementalPlanner::IncrementalPlanner(const Map* map)
+    : map(map), trapCost(1), initialized(false), goalIndex(-1), lastStartIndex(-1),
+      km(0), syncedRevision(0), expandedCount(0) {}
+
+void IncrementalPlanner::setTrapCost(int cost) {
+    cost = max(1, min(cost, 1000));
+    if (cost != trapCost) {
+        trapCost = cost;
+        initialized = false;  // 所有陷阱边的成本都变了，重新开始
+    }
+}
+
+bool IncrementalPlanner::plan(const Position& start, const Position& goal, vector<Position>& path) {
+    path.clear();
+    expandedCount = 0;
+
+    if (map->getCell(start.x, start.y) == WALL || map->getCell(goal.x, goal.y) == WALL) {
+        return false;
+    }
+
+    int startIndex = map->cellIndex(start.x, start.y);
+    int goalCell = map->cellIndex(goal.x, goal.y);
+
+    if (!initialized || goalCell != goalIndex || static_cast<int>(g.size()) != map->getCellCount()) {
+        initialize(startIndex, goalCell);
+    } else {
+        // 起点移动：先累加 km，保持堆中旧优先级的下界性质
+        if (startIndex != lastStartIndex) {
+            km += heuristic(lastStartIndex, startIndex);
+            lastStartIndex = startIndex;
+        }
+        // 同步地图修改；日志已截断时只能从头开始
+        if (!syncMapChanges()) {
+            initialize(startIndex, goalCell);
+        }
+    }
+
+    // 不连通时保留状态但不搜索
+    if (!map->isReachable(start, goal)) {
+        return false;
+    }
+
+    computeShortestPath(startIndex);
+    if (g[startIndex] >= INF) {
+        return false;
+    }
+
+    // 沿 成本 + g 最小的邻居走到终点
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+    int current = startIndex;
+    path.push_back(start);
+    while (current != goalIndex) {
+        int best = -1;
+        int bestCost = INF;
+        for (int i = 0; i < 4; i++) {
+            int next = current + offsets[i];
+            int cost = enterCost(next);
+            if (cost >= INF || g[next] >= INF) {
+                continue;
+            }
+            if (cost + g[next] < bestCost) {
+                bestCost = cost + g[next];
+                best = next;
+            }
+        }
+        if (best == -1 || path.size() > static_cast<size_t>(map->getCellCount())) {
+            path.clear();  // 状态不一致时放弃（理论上不会发生）
+            initialized = false;
+            return false;
+        }
+        current = best;
+        path.push_back(map->indexToPosition(current));
+    }
+    return true;
+}
+
+void IncrementalPlanner::initialize(int startIndex, int goalCell) {
+    int cellCount = map->getCellCount();
+    g.assign(cellCount, INF);
+    rhs.assign(cellCount, INF);
+    heapPos.assign(cellCount, -1);
+    heap.clear();
+
+    goalIndex = goalCell;
+    lastStartIndex = startIndex;
+    km = 0;
+    syncedRevision = map->getRevision();
+
+    rhs[goalIndex] = 0;
+    heapInsert(goalIndex, heuristic(startIndex, goalIndex), 0);
+    initialized = true;
+}
+
+bool IncrementalPlanner::syncMapChanges() {
+    if (map->getRevision() == syncedRevision) {
+        return true;
+    }
+    if (!map->getChangesSince(syncedRevision, changes)) {
+        return false;
+    }
+    syncedRevision = map->getRevision();
+
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+
+    for (const CellChange& change : changes) {
+        // 进入该格子的成本改变：该格子自身和四个邻居的 rhs 都可能受影响
+        int index = map->cellIndex(change.x, change.y);
+        updateVertex(index);
+        for (int i = 0; i < 4; i++) {
+            updateVertex(index + offsets[i]);
+        }
+    }
+    return true;
+}
+
+int IncrementalPlanner::enterCost(int index) const {
+    uint8_t type = map->data()[index];
+    if (type == WALL) return INF;
+    if (type == TRAP) return trapCost;
+    return 1;
+}
+
+int IncrementalPlanner::heuristic(int a, int b) const {
+    Position pa = map->indexToPosition(a);
+    Position pb = map->indexToPosition(b);
+    return abs(pa.x - pb.x) + abs(pa.y - pb.y);
+}
+
+void IncrementalPlanner::calculateKey(int index, int& k1, int& k2) const {
+    k2 = min(g[index], rhs[index]);
+    k1 = k2 >= INF ? INF : k2 + heuristic(lastStartIndex, index) + km;
+}
+
+void IncrementalPlanner::updateVertex(int index) {
+    if (map->data()[index] == WALL) {
+        // 墙壁（含边框）不可达
+        rhs[index] = INF;
+    } else if (index != goalIndex) {
+        // rhs = min(进入邻居的成本 + 邻居的 g)
+        const int stride = map->getStride();
+        const int offsets[] = {-stride, 1, stride, -1};
+        int best = INF;
+        for (int i = 0; i < 4; i++) {
+            int next = index + offsets[i];
+            int cost = enterCost(next);
+            if (cost < INF && g[next] < INF) {
+                best = min(best, cost + g[next]);
+            }
+        }
+        rhs[index] = best;
+    }
+
+    if (heapPos[index] != -1) {
+        heapRemove(index);
+    }
+    if (g[index] != rhs[index]) {
+        int k1, k2;
+        calculateKey(index, k1, k2);
+        heapInsert(index, k1, k2);
+    }
+}
+
+void IncrementalPlanner::computeShortestPath(int startIndex) {
+    const int stride = map->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};
+
+    while (!heap.empty()) {
+        int startK1, startK2;
+        calculateKey(startIndex, startK1, startK2);
+        HeapEntry top = heap[0];
+        HeapEntry startKey = {startK1, startK2, startIndex};
+        if (!keyLess(top, startKey) && rhs[startIndex] == g[startIndex]) {
+            break;
+        }
+
+        int u = top.index;
+        int k1, k2;
+        calculateKey(u, k1, k2);
+        HeapEntry newKey = {k1, k2, u};
+        expandedCount++;
+
+        if (keyLess(top, newKey)) {
+            // 优先级过期，按新优先级放回
+            heapRemove(u);
+            heapInsert(u, k1, k2);
+        } else if (g[u] > rhs[u]) {
+            // 局部过一致：降低 g 并通知前驱
+            g[u] = rhs[u];
+            heapRemove(u);
+            for (int i = 0; i < 4; i++) {
+                updateVertex(u + offsets[i]);
+            }
+        } else {
+            // 局部欠一致：g 置为无穷后重新计算自身和前驱
+            g[u] = INF;
+            updateVertex(u);
+            for (int i = 0; i < 4; i++) {
+                updateVertex(u + offsets[i]);
+            }
+        }
+    }
+}
+
+void IncrementalPlanner::heapInsert(int index, int k1, int k2) {
+    heap.push_back({k1, k2, index});
+    heapPos[index] = static_cast<int>(heap.size()) - 1;
+    siftUp(heapPos[index]);
+}
+
+void IncrementalPlanner::heapRemove(int index) {
+    int pos = heapPos[index];
+    int last = static_cast<int>(heap.size()) - 1;
+    if (pos != last) {
+        heapSwap(pos, last);
+    }
+    heap.pop_back();
+    heapPos[index] = -1;
+    if (pos < static_cast<int>(heap.size())) {
+        siftUp(pos);
+        siftDown(pos);
+    }
+}
+
+void IncrementalPlanner::siftUp(int pos) {
+    while (pos > 0) {
+        int parent = (pos - 1) / 2;
+        if (!keyLess(heap[pos], heap[parent])) break;
+        heapSwap(pos, parent);
+        pos = parent;
+    }
+}
+
+void IncrementalPlanner::siftDown(int pos) {
+    int size = static_cast<int>(heap.size());
+    while (true) {
+        int left = pos * 2 + 1;
+        int smallest = pos;
+        if (left < size && keyLess(heap[left], heap[smallest])) smallest = left;
+        if (left + 1 < size && keyLess(heap[left + 1], heap[smallest])) smallest = left + 1;
+        if (smallest == pos) break;
+        heapSwap(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void IncrementalPlanner::heapSwap(int a, int b) {
+    swap(heap[a], heap[b]);
+    heapPos[heap[a].index] = a;
+    heapPos[heap[b].index] = b;
+}
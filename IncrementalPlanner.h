@@ -0,0 +1,75 @@
+// IncrementalPlanner.h
+#ifndef INCREMENTALPLANNER_H
+#define INCREMENTALPLANNER_H
+
+#include "Map.h"
+#include "Position.h"
+#include <vector>
+#include <cstdint>
+
+// 增量路径规划（D* Lite）
+// 从终点向起点反向搜索并保留 g/rhs 值。终点不变时，后续调用只需：
+//   1. 通过 Map 的修改日志取出变化的格子，更新受影响的顶点；
+//   2. 起点移动时累加 km 修正优先级；
+// 然后只修复搜索树中受影响的部分，而不是从头搜索。
+// 进入普通格的成本为1，进入陷阱格的成本为 trapCost。
+class IncrementalPlanner {
+private:
+    struct HeapEntry {
+        int k1, k2;  // 优先级 [min(g,rhs) + h + km, min(g,rhs)]
+        int index;
+    };
+
+    const Map* map;
+    int trapCost;
+
+    bool initialized;
+    int goalIndex;
+    int lastStartIndex;
+    int km;
+    uint64_t syncedRevision;
+    int expandedCount;
+
+    std::vector<int> g, rhs;
+    std::vector<HeapEntry> heap;   // 带位置索引的二叉小顶堆
+    std::vector<int> heapPos;      // 每个格子在堆中的位置，-1 表示不在堆中
+    std::vector<CellChange> changes;
+
+public:
+    static constexpr int INF = 0x3FFFFFFF;
+
+    IncrementalPlanner(const Map* map);
+
+    void setTrapCost(int cost);
+
+    // 规划从 start 到 goal 的路径（包含两端），找到路径返回 true
+    bool plan(const Position& start, const Position& goal, std::vector<Position>& path);
+
+    // 丢弃保留的搜索状态
+    void reset() { initialized = false; }
+
+    // 最近一次规划扩展的节点数
+    int getLastExpandedCount() const { return expandedCount; }
+
+private:
+    void initialize(int startIndex, int goalCell);
+    bool syncMapChanges();
+
+    int enterCost(int index) const;
+    int heuristic(int a, int b) const;
+    void calculateKey(int index, int& k1, int& k2) const;
+    void updateVertex(int index);
+    void computeShortestPath(int startIndex);
+
+    // 堆操作
+    static bool keyLess(const HeapEntry& a, const HeapEntry& b) {
+        return a.k1 < b.k1 || (a.k1 == b.k1 && a.k2 < b.k2);
+    }
+    void heapInsert(int index, int k1, int k2);
+    void heapRemove(int index);
+    void siftUp(int pos);
+    void siftDown(int pos);
+    void heapSwap(int a, int b);
+};
+
+#endif
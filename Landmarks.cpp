@@ -0,0 +1,276 @@
+// Landmarks.cpp
+#include "Landmarks.h"
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char LANDMARK_MAGIC[8] = {'M', 'A', 'Z', 'E', 'A', 'L', 'T', '\0'};
+
+Landmarks::Landmarks()
+    : source(nullptr), revision(0), width(0), height(0), cellCount(0), mapChecksum(0), table(nullptr) {}
+
+void Landmarks::clear() {
+    source = nullptr;
+    landmarks.clear();
+    storage.clear();
+    storage.shrink_to_fit();
+    mapping.reset();
+    table = nullptr;
+    cellCount = 0;
+}
+
+uint64_t Landmarks::checksum(const Map& map) {
+    // FNV-1a 的变体：每次吸收 8 个字节
+    uint64_t hash = 1469598103934665603ULL;
+    auto mix = [&hash](uint64_t value) {
+        hash ^= value;
+        hash *= 1099511628211ULL;
+        hash ^= hash >> 29;
+    };
+    mix(static_cast<uint64_t>(map.getWidth()) << 32 | static_cast<uint32_t>(map.getHeight()));
+    Position start = map.getStartPosition();
+    Position end = map.getEndPosition();
+    mix(static_cast<uint64_t>(start.x) << 32 | static_cast<uint32_t>(start.y));
+    mix(static_cast<uint64_t>(end.x) << 32 | static_cast<uint32_t>(end.y));
+
+    const uint8_t* cells = map.data();
+    size_t count = static_cast<size_t>(map.getCellCount());
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint64_t word;
+        memcpy(&word, cells + i, sizeof(word));
+        mix(word);
+    }
+    for (; i < count; i++) {
+        mix(cells[i]);
+    }
+    return hash;
+}
+
+void Landmarks::selectLandmarks(const Map& map, int count) {
+    int w = map.getWidth();
+    int h = map.getHeight();
+
+    // 地标放在最大的连通分量里：落在小分量里的地标对其余格子给不出下界
+    vector<int> componentSize(map.getCellCount(), 0);
+    int largest = -1;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            int component = map.getComponent(x, y);
+            if (component < 0) {
+                continue;
+            }
+            componentSize[component]++;
+            if (largest < 0 || componentSize[component] > componentSize[largest]) {
+                largest = component;
+            }
+        }
+    }
+    if (largest < 0) {
+        return;  // 没有可通行的格子
+    }
+
+    // 外圈上的点：从左上角开始顺时针，按周长均匀分布
+    int perimeter = 2 * (w + h);
+    Position center(w / 2, h / 2);
+    for (int k = 0; k < count; k++) {
+        int t = static_cast<int>(static_cast<long long>(k) * perimeter / count);
+        Position edge;
+        if (t < w) edge = Position(t, 0);
+        else if (t < w + h) edge = Position(w - 1, t - w);
+        else if (t < 2 * w + h) edge = Position(w - 1 - (t - w - h), h - 1);
+        else edge = Position(0, h - 1 - (t - 2 * w - h));
+
+        // 从外圈点沿直线走向中心，取第一个位于最大连通分量的格子
+        int steps = max(abs(center.x - edge.x), abs(center.y - edge.y));
+        for (int s = 0; s <= steps; s++) {
+            int x = steps == 0 ? edge.x : edge.x + (center.x - edge.x) * s / steps;
+            int y = steps == 0 ? edge.y : edge.y + (center.y - edge.y) * s / steps;
+            if (map.getComponent(x, y) != largest) {
+                continue;
+            }
+            int index = map.cellIndex(x, y);
+            if (find(landmarks.begin(), landmarks.end(), index) == landmarks.end()) {
+                landmarks.push_back(index);
+            }
+            break;
+        }
+    }
+}
+
+void Landmarks::bfs(const Map& map, int sourceIndex, uint32_t* dist, vector<int>& queue) {
+    const uint8_t* cells = map.data();
+    int stride = map.getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+
+    queue.clear();
+    dist[sourceIndex] = 0;
+    queue.push_back(sourceIndex);
+    for (size_t head = 0; head < queue.size(); head++) {
+        int current = queue[head];
+        uint32_t next = dist[current] + 1;
+        for (int i = 0; i < 4; i++) {
+            int neighbor = current + offsets[i];
+            if (cells[neighbor] != WALL && dist[neighbor] == UNREACHABLE) {
+                dist[neighbor] = next;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+}
+
+void Landmarks::build(const Map& map, int count, int threadCount) {
+    clear();
+    count = max(1, min(count, MAX_COUNT));
+    selectLandmarks(map, count);
+
+    width = map.getWidth();
+    height = map.getHeight();
+    cellCount = map.getCellCount();
+    int landmarkCount = static_cast<int>(landmarks.size());
+    storage.assign(static_cast<size_t>(landmarkCount) * cellCount, UNREACHABLE);
+
+    // 每个线程依次领取一个地标做 BFS，各自写入自己的那张表
+    if (threadCount <= 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    threadCount = max(1, min(threadCount, landmarkCount));
+    atomic<int> nextLandmark(0);
+    auto worker = [&]() {
+        vector<int> queue;
+        int k;
+        while ((k = nextLandmark.fetch_add(1)) < landmarkCount) {
+            bfs(map, landmarks[k], storage.data() + static_cast<size_t>(k) * cellCount, queue);
+        }
+    };
+
+    vector<thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();  // 调用线程也参与计算
+    for (thread& t : workers) {
+        t.join();
+    }
+
+    table = storage.data();
+    source = &map;
+    revision = map.getRevision();
+    mapChecksum = checksum(map);
+}
+
+bool Landmarks::save(const string& path) const {
+    if (table == nullptr) return false;
+
+    LandmarkFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(LandmarkFileHeader);
+    header.width = width;
+    header.height = height;
+    header.count = static_cast<uint32_t>(landmarks.size());
+    header.mapChecksum = mapChecksum;
+    header.tableOffset = (sizeof(LandmarkFileHeader) + landmarks.size() * sizeof(int32_t) + 63) / 64 * 64;
+    header.tableBytes = static_cast<uint64_t>(landmarks.size()) * cellCount * sizeof(uint32_t);
+
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file) return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (int index : landmarks) {
+        int32_t value = index;
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+    vector<char> padding(header.tableOffset - sizeof(LandmarkFileHeader) - landmarks.size() * sizeof(int32_t), 0);
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char*>(table), header.tableBytes);
+    return static_cast<bool>(file);
+}
+
+bool Landmarks::load(const string& path, const Map& map) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(LandmarkFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) return false;
+
+    shared_ptr<const void> region(address, [fileSize](const void* p) {
+        munmap(const_cast<void*>(p), fileSize);
+    });
+    const uint8_t* bytes = static_cast<const uint8_t*>(address);
+#else
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file) return false;
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize < sizeof(LandmarkFileHeader)) return false;
+    auto buffer = make_shared<vector<uint8_t>>(fileSize);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer->data()), fileSize)) return false;
+    const uint8_t* bytes = buffer->data();
+    shared_ptr<const void> region(buffer, bytes);
+#endif
+
+    LandmarkFileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (memcmp(header.magic, LANDMARK_MAGIC, sizeof(LANDMARK_MAGIC)) != 0 || header.version != VERSION ||
+        header.headerSize != sizeof(LandmarkFileHeader)) {
+        return false;
+    }
+    if (header.width != map.getWidth() || header.height != map.getHeight() ||
+        header.count == 0 || header.count > static_cast<uint32_t>(MAX_COUNT)) {
+        return false;
+    }
+    uint64_t expectedBytes = static_cast<uint64_t>(header.count) * map.getCellCount() * sizeof(uint32_t);
+    if (header.tableBytes != expectedBytes || header.tableOffset % 64 != 0 ||
+        header.tableOffset < sizeof(LandmarkFileHeader) + header.count * sizeof(int32_t) ||
+        header.tableOffset > fileSize || header.tableBytes > fileSize - header.tableOffset) {
+        return false;
+    }
+    // 地图内容变过的表会给出不可采纳的启发值，必须拒绝
+    if (header.mapChecksum != checksum(map)) {
+        return false;
+    }
+
+    vector<int> indices(header.count);
+    for (uint32_t k = 0; k < header.count; k++) {
+        int32_t value;
+        memcpy(&value, bytes + sizeof(LandmarkFileHeader) + k * sizeof(int32_t), sizeof(value));
+        if (value < 0 || value >= map.getCellCount() || map.cellAt(value) == WALL) {
+            return false;
+        }
+        indices[k] = value;
+    }
+
+    clear();
+    landmarks.swap(indices);
+    width = header.width;
+    height = header.height;
+    cellCount = map.getCellCount();
+    mapChecksum = header.mapChecksum;
+    table = reinterpret_cast<const uint32_t*>(bytes + header.tableOffset);
+    mapping = region;
+    source = &map;
+    revision = map.getRevision();
+    return true;
+}
@@ -0,0 +1,95 @@
+// Landmarks.h
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include "Map.h"
+#include "Position.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+// 地标距离表（ALT：A*、地标、三角不等式）
+// 选取 K 个地标，预先计算每个地标到所有格子的 BFS 步数 d(L, ·)。
+// 对任意格子 n 和终点 t，|d(L, t) - d(L, n)| 不超过 n 到 t 的最短路长度，
+// 取各地标中的最大值作为启发值；在绕来绕去的迷宫里比曼哈顿距离准确得多。
+// 每步成本至少为1，因此该启发对带陷阱成本的路径同样可采纳。
+//
+// 距离表可保存为地图文件旁的 .alt 文件（小端，版本 1）：
+//   [0, 64)    文件头 LandmarkFileHeader
+//   [64, ...)  地标的线性下标（int32 x K）
+//   tableOffset 起为 K 张距离表，每张 cellCount 个 uint32，与内存布局相同，按 64 字节对齐
+// 文件头记录生成时地图内容的校验和，读取时不符即拒绝；表本身直接 mmap，读取时间与地图大小无关。
+class Landmarks {
+public:
+    static const uint32_t VERSION = 1;
+    static constexpr int DEFAULT_COUNT = 8;
+    static constexpr int MAX_COUNT = 16;
+    static constexpr uint32_t UNREACHABLE = 0xFFFFFFFFu;
+
+    Landmarks();
+
+    // 为 map 选取 count 个地标并构建距离表，各地标的 BFS 在线程池上并行计算
+    // threadCount 为 0 时使用硬件线程数
+    void build(const Map& map, int count = DEFAULT_COUNT, int threadCount = 0);
+
+    // 保存/读取距离表；读取时地图尺寸或内容校验和不符返回 false
+    bool save(const std::string& path) const;
+    bool load(const std::string& path, const Map& map);
+
+    // 距离表是否对应 map 的当前内容（按地图对象和修改计数判断）
+    bool matches(const Map& map) const {
+        return source == &map && revision == map.getRevision() && cellCount == map.getCellCount();
+    }
+    void clear();
+
+    int getCount() const { return static_cast<int>(landmarks.size()); }
+    int getLandmarkIndex(int k) const { return landmarks[k]; }
+
+    // 地标 k 到格子 index（含边框的线性下标）的步数，不连通为 UNREACHABLE
+    uint32_t distance(int k, int index) const {
+        return table[static_cast<size_t>(k) * cellCount + index];
+    }
+
+    // 地图内容（尺寸、起终点和全部格子）的校验和
+    static uint64_t checksum(const Map& map);
+
+    // 地图文件对应的地标文件路径
+    static std::string sidecarPath(const std::string& mapPath) { return mapPath + ".alt"; }
+
+private:
+    struct LandmarkFileHeader {
+        char magic[8];         // "MAZEALT\0"
+        uint32_t version;
+        uint32_t headerSize;   // sizeof(LandmarkFileHeader)
+        int32_t width, height;
+        uint32_t count;
+        uint32_t reserved;
+        uint64_t mapChecksum;
+        uint64_t tableOffset;
+        uint64_t tableBytes;   // count * cellCount * 4
+        uint64_t reserved2;
+    };
+    static_assert(sizeof(LandmarkFileHeader) == 64, "地标文件头必须为 64 字节");
+
+    const Map* source;
+    uint64_t revision;
+    int width, height;
+    int cellCount;
+    uint64_t mapChecksum;
+    std::vector<int> landmarks;
+
+    // 距离表：地标 k 的表位于 table[k * cellCount, (k + 1) * cellCount)
+    // 自己构建时存放在 storage 中，从文件读取时指向文件映射
+    const uint32_t* table;
+    std::vector<uint32_t> storage;
+    std::shared_ptr<const void> mapping;
+
+    // 沿地图外圈均匀取点，各自向地图中心找到第一个位于最大连通分量的格子
+    void selectLandmarks(const Map& map, int count);
+
+    // 从 source 出发的 BFS，结果写入 dist（调用前已填为 UNREACHABLE）
+    static void bfs(const Map& map, int sourceIndex, uint32_t* dist, std::vector<int>& queue);
+};
+
+#endif
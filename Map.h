@@ -0,0 +1,124 @@
+// Map.h
+#ifndef MAP_H
+#define MAP_H
+
+#include "Position.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+
+enum CellType {
+    EMPTY = 0,      // 可通行
+    WALL = 1,       // 墙壁
+    TRAP = 2,       // 陷阱
+    START = 3,      // 起点
+    END = 4         // 终点
+};
+
+struct MazeOptions;
+
+// 单元格修改记录（供增量算法同步地图变化）
+struct CellChange {
+    int x, y;
+    CellType oldType;
+    CellType newType;
+};
+
+class Map {
+private:
+    // 单元格按行连续存储，每格一个字节（CellType）
+    // 四周额外包一圈墙壁作为哨兵，热点循环访问相邻格子时无需边界检查
+    std::vector<uint8_t> cells;
+    int width, height;
+    int stride;  // 含边框的行宽（width + 2）
+    Position startPos;
+    Position endPos;
+    std::string mapName;
+    
+    // 只读映射视图：从地图文件 mmap 打开时 cells 为空，单元格直接读自文件映射；
+    // 第一次修改时复制到 cells（写时复制），映射本身保持只读、可被多个进程共享
+    const uint8_t* mappedCells;
+    std::shared_ptr<const void> mapping;
+    
+    // 连通分量索引（并查集，按线性下标存放父节点，墙壁为 -1）
+    // 首次查询时整体构建；setCell 打通格子时就地合并，砌墙时标记失效、下次查询再重建
+    mutable std::vector<int> componentParent;
+    mutable bool componentsValid;
+    
+    // 修改日志：revision 为累计修改次数，changeLog 保存最近的若干条修改
+    uint64_t revision;
+    std::vector<CellChange> changeLog;
+    static const size_t MAX_CHANGE_LOG = 4096;
+    
+    // 随机迷宫生成器直接写入存储，避免逐格 setCell 的日志和索引开销
+    friend class MazeGenerator;
+    friend class MapFile;
+
+public:
+    Map(int w, int h, const std::string& name = "Unnamed Map");
+    
+    // 地图操作
+    void setCell(int x, int y, CellType type);
+    CellType getCell(int x, int y) const;
+    
+    // 获取地图信息
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    Position getStartPosition() const { return startPos; }
+    Position getEndPosition() const { return endPos; }
+    std::string getName() const { return mapName; }
+    
+    // 原始存储访问（供寻路、渲染等热点循环使用）
+    // 下标均为含边框的线性下标，相邻格子的偏移为 ±1 和 ±stride
+    int getStride() const { return stride; }
+    int cellIndex(int x, int y) const { return (y + 1) * stride + (x + 1); }
+    Position indexToPosition(int index) const {
+        return Position(index % stride - 1, index / stride - 1);
+    }
+    int getCellCount() const { return stride * (height + 2); }  // 含边框
+    const uint8_t* data() const { return mappedCells ? mappedCells : cells.data(); }
+    const uint8_t* row(int y) const { return data() + cellIndex(0, y); }  // 第y行的width个格子
+    CellType cellAt(int index) const { return static_cast<CellType>(data()[index]); }
+    bool isMapped() const { return mappedCells != nullptr; }  // 是否仍直接读取文件映射
+    
+    // 验证地图有效性
+    bool isValidPosition(int x, int y) const;
+    bool hasValidPath() const;  // 检查是否存在从起点到终点的路径
+    
+    // 连通性查询（基于连通分量索引，均摊常数时间）
+    bool isReachable(const Position& from, const Position& to) const;
+    int getComponent(int x, int y) const;  // 所在连通分量的代表下标，墙壁返回 -1
+    void buildComponents() const;          // 立即构建索引并完全压缩（多线程只读查询前调用）
+    
+    // 只含单元格的只读快照（交给后台线程使用）：不复制连通分量索引和修改日志。
+    // 单元格放在共享的只读缓冲里，与文件映射一样写时复制；本身就是映射视图时直接共享，不复制
+    Map snapshot() const;
+    
+    // 修改日志
+    uint64_t getRevision() const { return revision; }
+    // 取出 since 之后的全部修改；日志已被截断时返回 false，调用方需整体重建
+    bool getChangesSince(uint64_t since, std::vector<CellChange>& changes) const;
+    
+    // 显示地图
+    void display() const;
+    
+private:
+    // 从文件映射切换为自有存储（写时复制）
+    void detach();
+    uint8_t* mutableData() { detach(); return cells.data(); }
+    
+    int findComponent(int index) const;
+    void uniteComponents(int a, int b) const;
+    
+public:
+    // 预设地图
+    static Map createMap1();
+    static Map createMap2();
+    
+    // 按种子生成随机迷宫（见 MazeGenerator.h）
+    static Map createRandomMap(const MazeOptions& options);
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,234 @@
+// MapFile.cpp
+#include "MapFile.h"
+#include <fstream>
+#include <vector>
+#include <cstring>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char MAP_MAGIC[8] = {'M', 'A', 'Z', 'E', 'M', 'A', 'P', '\0'};
+
+MapFile::MapFileHeader MapFile::makeHeader(int width, int height, const Position& start,
+                                           const Position& end, const string& name) {
+    MapFileHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MAP_MAGIC, sizeof(MAP_MAGIC));
+    header.version = VERSION;
+    header.headerSize = sizeof(MapFileHeader);
+    header.width = width;
+    header.height = height;
+    header.startX = start.x;
+    header.startY = start.y;
+    header.endX = end.x;
+    header.endY = end.y;
+    header.nameLength = static_cast<uint32_t>(name.size());
+    header.cellOffset = (sizeof(MapFileHeader) + name.size() + 63) / 64 * 64;
+    header.cellBytes = static_cast<uint64_t>(width + 2) * (height + 2);
+    return header;
+}
+
+bool MapFile::save(const Map& map, const string& path) {
+    string name = map.getName();
+    MapFileHeader header = makeHeader(map.getWidth(), map.getHeight(), map.getStartPosition(),
+                                      map.getEndPosition(), name);
+    
+    ofstream file(path, ios::binary | ios::trunc);
+    if (!file) return false;
+    
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(name.data(), name.size());
+    vector<char> padding(header.cellOffset - sizeof(MapFileHeader) - name.size(), 0);
+    file.write(padding.data(), padding.size());
+    file.write(reinterpret_cast<const char*>(map.data()), header.cellBytes);
+    return static_cast<bool>(file);
+}
+
+bool MapFile::validHeader(const MapFileHeader& header, uint64_t fileSize, uint64_t maxCellBytes) {
+    if (memcmp(header.magic, MAP_MAGIC, sizeof(MAP_MAGIC)) != 0 || header.version != VERSION ||
+        header.headerSize != sizeof(MapFileHeader)) {
+        return false;
+    }
+    if (header.width <= 0 || header.height <= 0 || header.width > 1000000 || header.height > 1000000) {
+        return false;
+    }
+    uint64_t expected = static_cast<uint64_t>(header.width + 2) * (header.height + 2);
+    if (header.cellBytes != expected || expected > maxCellBytes) {
+        return false;
+    }
+    // 偏移和长度来自文件，只做减法比较，防止加法回绕后越过检查
+    if (header.cellOffset < sizeof(MapFileHeader) ||
+        header.nameLength > header.cellOffset - sizeof(MapFileHeader) ||
+        header.cellOffset > fileSize || header.cellBytes > fileSize - header.cellOffset) {
+        return false;
+    }
+    return header.startX >= 0 && header.startX < header.width && header.startY >= 0 && header.startY < header.height &&
+           header.endX >= 0 && header.endX < header.width && header.endY >= 0 && header.endY < header.height;
+}
+
+bool MapFile::validBorder(const uint8_t* cells, int width, int height) {
+    // 只检查边框（寻路依赖它作为哨兵），内部格子不逐个校验，保证打开时间为 O(宽 + 高)
+    size_t stride = static_cast<size_t>(width) + 2;
+    const uint8_t* last = cells + stride * (height + 1);
+    for (size_t x = 0; x < stride; x++) {
+        if (cells[x] != WALL || last[x] != WALL) return false;
+    }
+    for (int y = 1; y <= height; y++) {
+        if (cells[y * stride] != WALL || cells[y * stride + stride - 1] != WALL) return false;
+    }
+    return true;
+}
+
+bool MapFile::open(const string& path, Map& map) {
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<uint64_t>(info.st_size) < sizeof(MapFileHeader)) {
+        ::close(fd);
+        return false;
+    }
+    size_t fileSize = static_cast<size_t>(info.st_size);
+    void* address = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // 映射建立后文件描述符不再需要
+    if (address == MAP_FAILED) return false;
+    
+    // 映射的生命周期由 shared_ptr 管理，Map 的所有副本共享同一份映射
+    shared_ptr<const void> region(address, [fileSize](const void* p) {
+        munmap(const_cast<void*>(p), fileSize);
+    });
+    const uint8_t* bytes = static_cast<const uint8_t*>(address);
+#else
+    // 没有 mmap 时整体读入内存
+    ifstream file(path, ios::binary | ios::ate);
+    if (!file) return false;
+    size_t fileSize = static_cast<size_t>(file.tellg());
+    if (fileSize < sizeof(MapFileHeader)) return false;
+    auto buffer = make_shared<vector<uint8_t>>(fileSize);
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer->data()), fileSize)) return false;
+    const uint8_t* bytes = buffer->data();
+    shared_ptr<const void> region(buffer, bytes);
+#endif
+    
+    MapFileHeader header;
+    memcpy(&header, bytes, sizeof(header));
+    if (!validHeader(header, fileSize, 0x7FFFFFFFu)) return false;  // Map 的线性下标为 int
+    
+    const uint8_t* cells = bytes + header.cellOffset;
+    if (!validBorder(cells, header.width, header.height)) return false;
+    
+    string name(reinterpret_cast<const char*>(bytes) + sizeof(MapFileHeader), header.nameLength);
+    
+    // 构造 1x1 的空地图再切换为映射视图，避免分配完整的单元格数组
+    Map view(1, 1, name);
+    view.width = header.width;
+    view.height = header.height;
+    view.stride = header.width + 2;
+    view.startPos = Position(header.startX, header.startY);
+    view.endPos = Position(header.endX, header.endY);
+    view.cells.clear();
+    view.cells.shrink_to_fit();
+    view.mappedCells = cells;
+    view.mapping = region;
+    
+    map = view;
+    return true;
+}
+
+bool MapFile::exportText(const Map& map, const string& path) {
+    ofstream file(path);
+    if (!file) return false;
+    
+    file << "=== " << map.getName() << " === (" << map.getWidth() << "x" << map.getHeight() << ")\n";
+    string line;
+    for (int y = 0; y < map.getHeight(); y++) {
+        const uint8_t* rowCells = map.row(y);
+        line.clear();
+        for (int x = 0; x < map.getWidth(); x++) {
+            switch (static_cast<CellType>(rowCells[x])) {
+                case WALL: line += '#'; break;
+                case TRAP: line += 'x'; break;
+                case START: line += 'S'; break;
+                case END: line += 'E'; break;
+                default: line += ' '; break;
+            }
+            line += ' ';
+        }
+        file << line << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+bool MapFile::importText(const string& path, Map& map) {
+    ifstream file(path);
+    if (!file) return false;
+    
+    string name = "Imported Map";
+    vector<string> lines;
+    string line;
+    while (getline(file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (lines.empty() && line.compare(0, 4, "=== ") == 0) {
+            // 标题行：=== 名称 === (宽x高)
+            size_t end = line.find(" ===", 4);
+            if (end != string::npos) name = line.substr(4, end - 4);
+            continue;
+        }
+        lines.push_back(line);
+    }
+    while (!lines.empty() && lines.back().find_first_not_of(' ') == string::npos) {
+        lines.pop_back();  // 去掉末尾的空行
+    }
+    if (lines.empty()) return false;
+    
+    // 判断是否为 display 的带空格格式：所有行的奇数位置都是空格
+    bool spaced = false;
+    bool oddAllSpaces = true;
+    for (const string& text : lines) {
+        spaced |= text.size() > 1;
+        for (size_t i = 1; i < text.size() && oddAllSpaces; i += 2) {
+            oddAllSpaces = text[i] == ' ';
+        }
+    }
+    spaced = spaced && oddAllSpaces;
+    
+    int step = spaced ? 2 : 1;
+    int width = 0;
+    for (const string& text : lines) {
+        width = max(width, static_cast<int>((text.size() + step - 1) / step));
+    }
+    int height = static_cast<int>(lines.size());
+    if (width == 0) return false;
+    
+    Map result(width, height, name);
+    uint8_t* cells = result.mutableData();
+    bool hasStart = false, hasEnd = false;
+    for (int y = 0; y < height; y++) {
+        const string& text = lines[y];
+        uint8_t* rowCells = cells + result.cellIndex(0, y);
+        for (int x = 0; x < width; x++) {
+            size_t i = static_cast<size_t>(x) * step;
+            char c = i < text.size() ? text[i] : ' ';
+            switch (c) {
+                case '#': rowCells[x] = WALL; break;
+                case 'x': rowCells[x] = TRAP; break;
+                case 'S': rowCells[x] = START; result.startPos = Position(x, y); hasStart = true; break;
+                case 'E': rowCells[x] = END; result.endPos = Position(x, y); hasEnd = true; break;
+                case ' ': case '.': rowCells[x] = EMPTY; break;
+                default: return false;
+            }
+        }
+    }
+    if (!hasStart || !hasEnd) return false;
+    
+    map = result;
+    return true;
+}
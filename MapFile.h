@@ -0,0 +1,61 @@
+// MapFile.h
+#ifndef MAPFILE_H
+#define MAPFILE_H
+
+#include "Map.h"
+#include <string>
+#include <cstdint>
+
+// 地图文件读写
+//
+// 二进制格式（小端，版本 1）：
+//   [0, 64)    文件头 MapFileHeader
+//   [64, ...)  地图名称（UTF-8，无结尾 0）
+//   cellOffset 起为单元格数组：与 Map 内存布局完全相同（含一圈墙壁边框，每格一个字节），
+//              cellOffset 按 64 字节对齐
+// 因为磁盘布局就是内存布局，open() 直接 mmap 整个文件，打开时间与地图大小无关，
+// 同一文件在各进程间共享页缓存；第一次 setCell 时才复制出私有副本。
+//
+// 文本格式与 Map::display 的输出相同：可选的 "=== 名称 === (宽x高)" 标题行，
+// 之后每行一排格子，'#' 墙壁、'x' 陷阱、'S' 起点、'E' 终点、空格或 '.' 为通道，
+// 格子之间可以有一个空格分隔。
+class MapFile {
+public:
+    static const uint32_t VERSION = 1;
+    
+    // 保存为二进制格式
+    static bool save(const Map& map, const std::string& path);
+    
+    // 以只读映射方式打开二进制地图（不支持 mmap 的平台退化为整体读入）
+    static bool open(const std::string& path, Map& map);
+    
+    // 文本格式导入/导出
+    static bool importText(const std::string& path, Map& map);
+    static bool exportText(const Map& map, const std::string& path);
+    
+private:
+    struct MapFileHeader {
+        char magic[8];         // "MAZEMAP\0"
+        uint32_t version;
+        uint32_t headerSize;   // sizeof(MapFileHeader)
+        int32_t width, height;
+        int32_t startX, startY;
+        int32_t endX, endY;
+        uint32_t nameLength;
+        uint32_t reserved;
+        uint64_t cellOffset;
+        uint64_t cellBytes;    // (width + 2) * (height + 2)
+    };
+    static_assert(sizeof(MapFileHeader) == 64, "地图文件头必须为 64 字节");
+    
+    static MapFileHeader makeHeader(int width, int height, const Position& start,
+                                    const Position& end, const std::string& name);
+    
+    // maxCellBytes：Map 的下标为 int，分页地图不受此限制
+    static bool validHeader(const MapFileHeader& header, uint64_t fileSize, uint64_t maxCellBytes);
+    
+    friend class PagedMap;
+    static bool validBorder(const uint8_t* cells, int width, int height);
+};
+
+#endif
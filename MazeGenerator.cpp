@@ -0,0 +1,269 @@
+// MazeGenerator.cpp
+#include "MazeGenerator.h"
+#include <algorithm>
+
+using namespace std;
+
+// 方向：上、右、下、左
+static const int DIR_X[4] = {0, 1, 0, -1};
+static const int DIR_Y[4] = {-1, 0, 1, 0};
+
+uint64_t MazeGenerator::Random::next() {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint32_t MazeGenerator::Random::below(uint32_t bound) {
+    // 乘法取高位代替取模
+    return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+}
+
+bool MazeGenerator::Random::chance(double p) {
+    if (p <= 0.0) return false;
+    if (p >= 1.0) return true;
+    return (next() >> 11) * (1.0 / 9007199254740992.0) < p;
+}
+
+bool MazeGenerator::parseAlgorithm(const string& name, MazeAlgorithm& algorithm) {
+    if (name == "backtracker") algorithm = MAZE_BACKTRACKER;
+    else if (name == "wilson") algorithm = MAZE_WILSON;
+    else if (name == "eller") algorithm = MAZE_ELLER;
+    else return false;
+    return true;
+}
+
+Map MazeGenerator::generate(const MazeOptions& options) {
+    // 每个方向至少两个迷宫格，否则起点和终点落在同一格
+    int width = max(MIN_SIZE, options.width);
+    int height = max(MIN_SIZE, options.height);
+    Map map(width, height, options.name);
+    
+    // 全部填为墙壁（边框本来就是墙）
+    for (int y = 0; y < height; y++) {
+        uint8_t* cells = rowOf(map, y);
+        fill(cells, cells + width, static_cast<uint8_t>(WALL));
+    }
+    
+    // 尺寸为偶数时最后一行/列保持为墙
+    int cellsX = (width - 1) / 2;
+    int cellsY = (height - 1) / 2;
+    Random rng(options.seed);
+    
+    switch (options.algorithm) {
+        case MAZE_BACKTRACKER: carveBacktracker(map, cellsX, cellsY, rng); break;
+        case MAZE_WILSON: carveWilson(map, cellsX, cellsY, rng); break;
+        default: carveEller(map, cellsX, cellsY, rng); break;
+    }
+    
+    braid(map, cellsX, cellsY, options.braidDensity, rng);
+    placeTraps(map, options.trapDensity, rng);
+    
+    // 起点和终点放在对角的两个迷宫格
+    map.startPos = Position(1, 1);
+    map.endPos = Position(2 * cellsX - 1, 2 * cellsY - 1);
+    rowOf(map, map.startPos.y)[map.startPos.x] = START;
+    rowOf(map, map.endPos.y)[map.endPos.x] = END;
+    
+    return map;
+}
+
+void MazeGenerator::openWall(Map& map, int cx, int cy, int dir) {
+    int x = 2 * cx + 1, y = 2 * cy + 1;
+    rowOf(map, y)[x] = EMPTY;
+    rowOf(map, y + DIR_Y[dir])[x + DIR_X[dir]] = EMPTY;
+    rowOf(map, y + 2 * DIR_Y[dir])[x + 2 * DIR_X[dir]] = EMPTY;
+}
+
+void MazeGenerator::carveBacktracker(Map& map, int cellsX, int cellsY, Random& rng) {
+    // 不用显式栈：from[i] 记录回到父节点的方向（4 表示根，0xFF 表示未访问），
+    // 回溯时沿该方向走回去，额外内存为每个迷宫格一个字节
+    const uint8_t UNVISITED = 0xFF, ROOT = 4;
+    vector<uint8_t> from(static_cast<size_t>(cellsX) * cellsY, UNVISITED);
+    
+    int cx = 0, cy = 0;
+    from[0] = ROOT;
+    rowOf(map, 1)[1] = EMPTY;
+    
+    while (true) {
+        int candidates[4];
+        int count = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = cx + DIR_X[d], ny = cy + DIR_Y[d];
+            if (nx >= 0 && nx < cellsX && ny >= 0 && ny < cellsY &&
+                from[static_cast<size_t>(ny) * cellsX + nx] == UNVISITED) {
+                candidates[count++] = d;
+            }
+        }
+        
+        if (count > 0) {
+            int d = candidates[rng.below(count)];
+            openWall(map, cx, cy, d);
+            cx += DIR_X[d];
+            cy += DIR_Y[d];
+            from[static_cast<size_t>(cy) * cellsX + cx] = static_cast<uint8_t>((d + 2) & 3);
+        } else {
+            uint8_t back = from[static_cast<size_t>(cy) * cellsX + cx];
+            if (back == ROOT) break;
+            cx += DIR_X[back];
+            cy += DIR_Y[back];
+        }
+    }
+}
+
+void MazeGenerator::carveWilson(Map& map, int cellsX, int cellsY, Random& rng) {
+    // 从不在树中的格子出发随机游走，只记录每格最后一次离开的方向（即擦除了环路），
+    // 碰到树后沿记录的方向把这条路径加入树
+    size_t total = static_cast<size_t>(cellsX) * cellsY;
+    vector<uint8_t> inTree(total, 0);
+    vector<uint8_t> walkDir(total, 0);
+    
+    size_t root = rng.below(static_cast<uint32_t>(total));
+    inTree[root] = 1;
+    rowOf(map, 2 * static_cast<int>(root / cellsX) + 1)[2 * static_cast<int>(root % cellsX) + 1] = EMPTY;
+    
+    for (size_t start = 0; start < total; start++) {
+        if (inTree[start]) continue;
+        
+        // 随机游走直到碰到树
+        int cx = static_cast<int>(start % cellsX), cy = static_cast<int>(start / cellsX);
+        while (!inTree[static_cast<size_t>(cy) * cellsX + cx]) {
+            int d;
+            int nx, ny;
+            do {
+                d = static_cast<int>(rng.below(4));
+                nx = cx + DIR_X[d];
+                ny = cy + DIR_Y[d];
+            } while (nx < 0 || nx >= cellsX || ny < 0 || ny >= cellsY);
+            walkDir[static_cast<size_t>(cy) * cellsX + cx] = static_cast<uint8_t>(d);
+            cx = nx;
+            cy = ny;
+        }
+        
+        // 沿擦除环路后的路径加入树
+        cx = static_cast<int>(start % cellsX);
+        cy = static_cast<int>(start / cellsX);
+        while (!inTree[static_cast<size_t>(cy) * cellsX + cx]) {
+            size_t index = static_cast<size_t>(cy) * cellsX + cx;
+            int d = walkDir[index];
+            inTree[index] = 1;
+            openWall(map, cx, cy, d);
+            cx += DIR_X[d];
+            cy += DIR_Y[d];
+        }
+    }
+}
+
+void MazeGenerator::carveEller(Map& map, int cellsX, int cellsY, Random& rng) {
+    // 逐行生成，只保存当前行每个格子所属的集合：
+    //   1. 随机合并相邻的不同集合（最后一行必须全部合并）；
+    //   2. 每个集合至少向下打通一格，没有向下连通的格子在下一行获得新集合。
+    // 行内的集合合并用一个按列下标的小并查集，额外内存为 O(cellsX)
+    vector<int> label(cellsX), nextLabel(cellsX, -1), remap(cellsX, -1);
+    vector<int> parent(cellsX), remaining(cellsX);
+    vector<uint8_t> hasDown(cellsX);
+    
+    auto find = [&parent](int a) {
+        while (parent[a] != a) {
+            parent[a] = parent[parent[a]];
+            a = parent[a];
+        }
+        return a;
+    };
+    
+    for (int cy = 0; cy < cellsY; cy++) {
+        bool lastRow = (cy == cellsY - 1);
+        uint8_t* cells = rowOf(map, 2 * cy + 1);
+        
+        // 把上一行传下来的集合重新编号为 [0, cellsX)，新格子使用剩余的编号
+        int used = 0;
+        for (int i = 0; i < cellsX; i++) {
+            if (nextLabel[i] >= 0) {
+                if (remap[nextLabel[i]] < 0) remap[nextLabel[i]] = used++;
+                label[i] = remap[nextLabel[i]];
+            }
+        }
+        for (int i = 0; i < cellsX; i++) {
+            if (nextLabel[i] >= 0) {
+                remap[nextLabel[i]] = -1;
+            } else {
+                label[i] = used++;
+            }
+            cells[2 * i + 1] = EMPTY;
+            parent[i] = i;
+        }
+        
+        // 水平合并
+        for (int i = 0; i + 1 < cellsX; i++) {
+            int a = find(label[i]), b = find(label[i + 1]);
+            if (a != b && (lastRow || rng.chance(0.5))) {
+                parent[max(a, b)] = min(a, b);
+                cells[2 * i + 2] = EMPTY;
+            }
+        }
+        if (lastRow) break;
+        
+        // 向下打通：每个集合至少一格
+        for (int i = 0; i < cellsX; i++) {
+            label[i] = find(label[i]);
+            remaining[label[i]] = 0;
+            hasDown[label[i]] = 0;
+        }
+        for (int i = 0; i < cellsX; i++) {
+            remaining[label[i]]++;
+        }
+        uint8_t* below = rowOf(map, 2 * cy + 2);
+        for (int i = 0; i < cellsX; i++) {
+            int set = label[i];
+            remaining[set]--;
+            if (rng.chance(0.5) || (remaining[set] == 0 && !hasDown[set])) {
+                below[2 * i + 1] = EMPTY;
+                hasDown[set] = 1;
+                nextLabel[i] = set;
+            } else {
+                nextLabel[i] = -1;
+            }
+        }
+    }
+}
+
+void MazeGenerator::braid(Map& map, int cellsX, int cellsY, double density, Random& rng) {
+    // 逐个迷宫格检查：只有一个出口的死胡同按概率打通另一面墙，形成环路
+    if (density <= 0.0) return;
+    
+    for (int cy = 0; cy < cellsY; cy++) {
+        for (int cx = 0; cx < cellsX; cx++) {
+            int x = 2 * cx + 1, y = 2 * cy + 1;
+            int exits = 0;
+            int closed[4];
+            int closedCount = 0;
+            for (int d = 0; d < 4; d++) {
+                if (rowOf(map, y + DIR_Y[d])[x + DIR_X[d]] != WALL) {
+                    exits++;
+                } else {
+                    int nx = cx + DIR_X[d], ny = cy + DIR_Y[d];
+                    if (nx >= 0 && nx < cellsX && ny >= 0 && ny < cellsY) {
+                        closed[closedCount++] = d;
+                    }
+                }
+            }
+            if (exits == 1 && closedCount > 0 && rng.chance(density)) {
+                openWall(map, cx, cy, closed[rng.below(closedCount)]);
+            }
+        }
+    }
+}
+
+void MazeGenerator::placeTraps(Map& map, double density, Random& rng) {
+    if (density <= 0.0) return;
+    
+    for (int y = 0; y < map.getHeight(); y++) {
+        uint8_t* cells = rowOf(map, y);
+        for (int x = 0; x < map.getWidth(); x++) {
+            if (cells[x] == EMPTY && rng.chance(density)) {
+                cells[x] = TRAP;
+            }
+        }
+    }
+}
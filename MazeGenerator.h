@@ -0,0 +1,68 @@
+// MazeGenerator.h
+#ifndef MAZEGENERATOR_H
+#define MAZEGENERATOR_H
+
+#include "Map.h"
+#include <vector>
+#include <string>
+#include <cstdint>
+
+// 迷宫生成算法
+enum MazeAlgorithm {
+    MAZE_BACKTRACKER = 0,  // 递归回溯（深度优先），长走廊、分支少
+    MAZE_WILSON = 1,       // Wilson 算法（擦除环路的随机游走），均匀生成树
+    MAZE_ELLER = 2         // Eller 算法，逐行生成，只保存一行的状态
+};
+
+// 随机迷宫参数
+struct MazeOptions {
+    int width, height;      // 地图尺寸（格子数，含外墙），小于 MIN_SIZE 时按 MIN_SIZE 生成
+    MazeAlgorithm algorithm;
+    uint64_t seed;
+    double braidDensity;    // 打通死胡同的比例 [0, 1]，大于0时迷宫出现环路
+    double trapDensity;     // 通道格子变为陷阱的概率 [0, 1]
+    std::string name;
+    
+    MazeOptions(int w = 63, int h = 63, MazeAlgorithm algo = MAZE_ELLER, uint64_t s = 1)
+        : width(w), height(h), algorithm(algo), seed(s),
+          braidDensity(0.0), trapDensity(0.0), name("Random Maze") {}
+};
+
+// 可复现的随机迷宫生成器
+// 迷宫格位于奇数坐标 (2i+1, 2j+1)，其余格子初始为墙壁，生成过程只打通格子之间的墙。
+// 生成的是完全迷宫（任意两格之间恰有一条路径），起点在左上角、终点在右下角，
+// 之后的打通死胡同和放置陷阱都不会产生墙壁，因此起点到终点始终连通。
+// 直接写入 Map 的存储，不经过 setCell，也不产生修改日志。
+class MazeGenerator {
+public:
+    static constexpr int MIN_SIZE = 5;  // 最小边长：每个方向至少两个迷宫格
+    
+    static Map generate(const MazeOptions& options);
+    
+    // 从名称解析算法（"backtracker" / "wilson" / "eller"），无法识别时返回 false
+    static bool parseAlgorithm(const std::string& name, MazeAlgorithm& algorithm);
+    
+private:
+    // splitmix64：状态只有一个 64 位整数，同一种子在各平台上结果一致
+    class Random {
+    private:
+        uint64_t state;
+    public:
+        explicit Random(uint64_t seed) : state(seed) {}
+        uint64_t next();
+        uint32_t below(uint32_t bound);  // [0, bound)
+        bool chance(double p);           // 以概率 p 返回 true
+    };
+    
+    static void carveBacktracker(Map& map, int cellsX, int cellsY, Random& rng);
+    static void carveWilson(Map& map, int cellsX, int cellsY, Random& rng);
+    static void carveEller(Map& map, int cellsX, int cellsY, Random& rng);
+    static void braid(Map& map, int cellsX, int cellsY, double density, Random& rng);
+    static void placeTraps(Map& map, double density, Random& rng);
+    
+    static uint8_t* rowOf(Map& map, int y) { return map.mutableData() + map.cellIndex(0, y); }
+    // 打通迷宫格 (cx, cy) 与方向 dir 上相邻迷宫格之间的墙
+    static void openWall(Map& map, int cx, int cy, int dir);
+};
+
+#endif
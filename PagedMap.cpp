@@ -0,0 +1,230 @@
+// PagedMap.cpp
+#include "PagedMap.h"
+#include "MapFile.h"
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+PagedMap::PagedMap(size_t memoryBudget)
+    : width(0), height(0), chunksX(0), chunksY(0), cellOffset(0), headerDirty(false),
+      lastChunk(nullptr), chunkLoads(0) {
+    maxChunks = max<size_t>(4, memoryBudget / (CHUNK_SIZE * CHUNK_SIZE));
+}
+
+PagedMap::~PagedMap() {
+    close();
+}
+
+void PagedMap::close() {
+    if (file.is_open()) {
+        flush();
+        file.close();
+    }
+    for (auto& entry : chunks) {
+        delete entry.second;
+    }
+    for (Chunk* chunk : freeChunks) {
+        delete chunk;
+    }
+    chunks.clear();
+    freeChunks.clear();
+    lru.clear();
+    lastChunk = nullptr;
+}
+
+bool PagedMap::open(const string& filePath) {
+    close();
+    file.open(filePath, ios::in | ios::out | ios::binary);
+    if (!file) return false;
+    
+    file.seekg(0, ios::end);
+    uint64_t fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(0);
+    
+    MapFile::MapFileHeader header;
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        !MapFile::validHeader(header, fileSize, UINT64_MAX)) {
+        file.close();
+        return false;
+    }
+    
+    mapName.assign(header.nameLength, '\0');
+    file.read(&mapName[0], header.nameLength);
+    
+    path = filePath;
+    width = header.width;
+    height = header.height;
+    chunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    chunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    cellOffset = header.cellOffset;
+    startPos = Position(header.startX, header.startY);
+    endPos = Position(header.endX, header.endY);
+    headerDirty = false;
+    chunkLoads = 0;
+    return static_cast<bool>(file);
+}
+
+bool PagedMap::create(const string& filePath, int w, int h, const string& name) {
+    close();
+    if (w <= 0 || h <= 0) return false;
+    
+    // 起点/终点先记为左上角和右下角（不写入格子），调用方用 setCell 设置
+    MapFile::MapFileHeader header = MapFile::makeHeader(w, h, Position(0, 0), Position(w - 1, h - 1), name);
+    {
+        ofstream out(filePath, ios::binary | ios::trunc);
+        if (!out) return false;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(name.data(), name.size());
+        
+        // 内部格子为 EMPTY（0），文件空洞即可；只写入边框的墙壁
+        uint64_t stride = static_cast<uint64_t>(w) + 2;
+        vector<char> wallRow(stride, static_cast<char>(WALL));
+        out.seekp(header.cellOffset);
+        out.write(wallRow.data(), stride);
+        const char walls[2] = {static_cast<char>(WALL), static_cast<char>(WALL)};
+        for (int y = 0; y < h; y++) {
+            // 本行的右边框和下一行的左边框相邻，一次写两个字节
+            out.seekp(header.cellOffset + (y + 1) * stride + stride - 1);
+            out.write(walls, 2);
+        }
+        out.seekp(header.cellOffset + (h + 1) * stride + 1);
+        out.write(wallRow.data(), stride - 1);
+        if (!out) return false;
+    }
+    
+    return open(filePath);
+}
+
+bool PagedMap::writeHeader() {
+    MapFile::MapFileHeader header = MapFile::makeHeader(width, height, startPos, endPos, mapName);
+    header.cellOffset = cellOffset;
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    headerDirty = false;
+    return static_cast<bool>(file);
+}
+
+bool PagedMap::flush() {
+    if (!file.is_open()) return false;
+    bool ok = true;
+    for (auto& entry : chunks) {
+        if (entry.second->dirty) {
+            ok = writeChunk(*entry.second) && ok;
+            entry.second->dirty = false;
+        }
+    }
+    if (headerDirty) {
+        ok = writeHeader() && ok;
+    }
+    file.flush();
+    return ok && static_cast<bool>(file);
+}
+
+PagedMap::Chunk* PagedMap::loadChunk(int64_t key) const {
+    Chunk* chunk;
+    if (chunks.size() >= maxChunks) {
+        // 淘汰最久未用的块
+        chunk = lru.back();
+        lru.pop_back();
+        chunks.erase(chunk->key);
+        if (chunk->dirty) {
+            writeChunk(*chunk);
+        }
+    } else if (!freeChunks.empty()) {
+        chunk = freeChunks.back();
+        freeChunks.pop_back();
+    } else {
+        chunk = new Chunk;
+        chunk->cells.resize(CHUNK_SIZE * CHUNK_SIZE);
+    }
+    
+    chunk->key = key;
+    chunk->dirty = false;
+    int x0 = static_cast<int>(key % chunksX) * CHUNK_SIZE;
+    int y0 = static_cast<int>(key / chunksX) * CHUNK_SIZE;
+    int w = min(CHUNK_SIZE, width - x0);
+    int h = min(CHUNK_SIZE, height - y0);
+    
+    // 块在文件中是 h 段不连续的行，逐行读入；超出地图的部分填墙
+    fill(chunk->cells.begin(), chunk->cells.end(), static_cast<uint8_t>(WALL));
+    file.clear();
+    for (int r = 0; r < h; r++) {
+        file.seekg(fileOffset(x0, y0 + r));
+        file.read(reinterpret_cast<char*>(chunk->cells.data() + r * CHUNK_SIZE), w);
+    }
+    
+    lru.push_front(chunk);
+    chunk->lruPos = lru.begin();
+    chunks[key] = chunk;
+    chunkLoads++;
+    return chunk;
+}
+
+bool PagedMap::writeChunk(const Chunk& chunk) const {
+    int x0 = static_cast<int>(chunk.key % chunksX) * CHUNK_SIZE;
+    int y0 = static_cast<int>(chunk.key / chunksX) * CHUNK_SIZE;
+    int w = min(CHUNK_SIZE, width - x0);
+    int h = min(CHUNK_SIZE, height - y0);
+    
+    file.clear();
+    for (int r = 0; r < h; r++) {
+        file.seekp(fileOffset(x0, y0 + r));
+        file.write(reinterpret_cast<const char*>(chunk.cells.data() + r * CHUNK_SIZE), w);
+    }
+    return static_cast<bool>(file);
+}
+
+PagedMap::Chunk* PagedMap::chunkFor(int x, int y) const {
+    int64_t key = static_cast<int64_t>(y / CHUNK_SIZE) * chunksX + x / CHUNK_SIZE;
+    if (lastChunk != nullptr && lastChunk->key == key) {
+        return lastChunk;
+    }
+    
+    auto it = chunks.find(key);
+    Chunk* chunk;
+    if (it != chunks.end()) {
+        chunk = it->second;
+        lru.splice(lru.begin(), lru, chunk->lruPos);  // 移到表头
+    } else {
+        chunk = loadChunk(key);
+    }
+    lastChunk = chunk;
+    return chunk;
+}
+
+CellType PagedMap::getCell(int x, int y) const {
+    if (!isValidPosition(x, y)) {
+        return WALL;  // 无效位置视为墙壁
+    }
+    const Chunk* chunk = chunkFor(x, y);
+    return static_cast<CellType>(chunk->cells[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE]);
+}
+
+void PagedMap::setCell(int x, int y, CellType type) {
+    if (!isValidPosition(x, y)) return;
+    Chunk* chunk = chunkFor(x, y);
+    chunk->cells[(y % CHUNK_SIZE) * CHUNK_SIZE + x % CHUNK_SIZE] = static_cast<uint8_t>(type);
+    chunk->dirty = true;
+    
+    if (type == START) {
+        startPos = Position(x, y);
+        headerDirty = true;
+    } else if (type == END) {
+        endPos = Position(x, y);
+        headerDirty = true;
+    }
+}
+
+Map PagedMap::extract(int x0, int y0, int w, int h) const {
+    Map view(max(1, w), max(1, h), mapName);
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            CellType type = getCell(x0 + x, y0 + y);
+            if (type != EMPTY) {
+                view.setCell(x, y, type);
+            }
+        }
+    }
+    return view;
+}
@@ -0,0 +1,99 @@
+// PagedMap.h
+#ifndef PAGEDMAP_H
+#define PAGEDMAP_H
+
+#include "Map.h"
+#include "Position.h"
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <string>
+#include <fstream>
+#include <cstdint>
+
+// 分块分页的地图存储（用于放不进内存的超大地图）
+// 地图保存在 MapFile 二进制格式的文件中，按 CHUNK_SIZE x CHUNK_SIZE 的块按需读入，
+// 超出内存预算时按 LRU 淘汰最久未用的块，被修改过的块淘汰时写回文件。
+// 接口与 Map 的 getCell/setCell 相同；没有整块连续存储，因此没有 data()/row()，
+// 寻路使用 PathFinder::findPathSparse，渲染用 extract() 取出视口。
+// 线性下标用 64 位，宽高可以到 100k x 100k 以上。
+class PagedMap {
+public:
+    static constexpr int CHUNK_SIZE = 64;
+    
+private:
+    struct Chunk {
+        int64_t key;
+        std::vector<uint8_t> cells;  // CHUNK_SIZE * CHUNK_SIZE，超出地图的部分为墙壁
+        bool dirty;
+        std::list<Chunk*>::iterator lruPos;
+    };
+    
+    mutable std::fstream file;
+    std::string path;
+    int width, height;
+    int chunksX, chunksY;
+    uint64_t cellOffset;     // 单元格数组在文件中的偏移
+    Position startPos, endPos;
+    std::string mapName;
+    bool headerDirty;
+    
+    // 已载入的块（逻辑上只读的查询也会载入/淘汰块，因此为 mutable）
+    size_t maxChunks;
+    mutable std::unordered_map<int64_t, Chunk*> chunks;
+    mutable std::list<Chunk*> lru;        // 表头为最近使用
+    mutable std::vector<Chunk*> freeChunks;
+    mutable Chunk* lastChunk;             // 最近访问的块，连续访问同一块时跳过哈希查找
+    mutable uint64_t chunkLoads;
+    
+public:
+    // memoryBudget 为块缓存的字节数上限（至少保留 4 个块）
+    PagedMap(size_t memoryBudget = 64u << 20);
+    ~PagedMap();
+    
+    PagedMap(const PagedMap&) = delete;
+    PagedMap& operator=(const PagedMap&) = delete;
+    
+    // 打开已有的地图文件（MapFile::save 或 create 生成）
+    bool open(const std::string& filePath);
+    
+    // 新建全空（四周为墙）的地图文件并打开；文件以稀疏方式扩展，不会真正写满
+    bool create(const std::string& filePath, int w, int h, const std::string& name = "Paged Map");
+    
+    // 写回所有修改过的块和文件头
+    bool flush();
+    
+    bool isOpen() const { return file.is_open(); }
+    
+    // 地图操作（与 Map 相同）
+    void setCell(int x, int y, CellType type);
+    CellType getCell(int x, int y) const;
+    bool isValidPosition(int x, int y) const {
+        return x >= 0 && x < width && y >= 0 && y < height;
+    }
+    
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    Position getStartPosition() const { return startPos; }
+    Position getEndPosition() const { return endPos; }
+    std::string getName() const { return mapName; }
+    
+    // 复制出 (x0, y0) 起 w x h 的视口，视口外的部分为墙壁；起点/终点在视口内时保留
+    Map extract(int x0, int y0, int w, int h) const;
+    
+    // 缓存统计
+    size_t getLoadedChunks() const { return chunks.size(); }
+    uint64_t getChunkLoads() const { return chunkLoads; }
+    
+private:
+    void close();
+    Chunk* chunkFor(int x, int y) const;
+    Chunk* loadChunk(int64_t key) const;
+    bool writeChunk(const Chunk& chunk) const;
+    bool writeHeader();
+    uint64_t fileOffset(int x, int y) const {
+        return cellOffset + static_cast<uint64_t>(y + 1) * (static_cast<uint64_t>(width) + 2) + (x + 1);
+    }
+};
+
+#endif
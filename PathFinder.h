@@ -4,48 +4,156 @@
 
 #include "Map.h"
 #include "Position.h"
+#include "SearchContext.h"
+#include "IncrementalPlanner.h"
+#include "DistanceField.h"
+#include "HierarchicalPlanner.h"
+#include "Landmarks.h"
+#include "CorridorGraph.h"
 #include <vector>
-#include <queue>
-#include <unordered_map>
-#include <functional>
+#include <string>
+#include <cstddef>
 
-struct Node {
-    Position pos;
-    int gCost;  // 从起点到当前节点的成本
-    int hCost;  // 到终点的预估成本
-    int fCost() const { return gCost + hCost; }
-    Node* parent;
-    
-    Node(Position p, int g = 0, int h = 0, Node* par = nullptr)
-        : pos(p), gCost(g), hCost(h), parent(par) {}
-    
-    bool operator>(const Node& other) const {
-        return fCost() > other.fCost();
-    }
+class PagedMap;
+
+// 搜索模式
+enum SearchMode {
+    SEARCH_ASTAR = 0,   // 标准 A*
+    SEARCH_JPS = 1,     // 跳点搜索（四连通、统一步长网格）
+    SEARCH_WEIGHTED = 2,    // 带权搜索：陷阱格有额外成本，可限制生命值预算
+    SEARCH_INCREMENTAL = 3, // 增量规划（D* Lite）：跨调用保留搜索状态，地图变化或起点移动时只做局部修复
+    SEARCH_DISTANCE_FIELD = 4, // 终点距离场：目标为地图终点时沿距离场下降，无需搜索
+    SEARCH_HIERARCHICAL = 5,   // 分层寻路（HPA*）：先在簇抽象图上搜索再逐簇细化，适合大地图上的长距离查询
+    SEARCH_ALT = 6,            // 地标启发（ALT）：A* 以地标距离表的三角不等式下界作启发，表与地图不一致时先重建
+    SEARCH_CORRIDOR = 7        // 通道收缩：通道收缩为关键格之间的带权边，在收缩图上搜索后展开为逐格路径
+};
+
+// 批量查询的输入与结果
+struct PathQuery {
+    Position start;
+    Position end;
+};
+
+struct PathResult {
+    bool found;
+    int length;                  // 路径步数，找不到路径时为 -1
+    std::vector<Position> path;  // 只求长度时为空
+    
+    PathResult() : found(false), length(-1) {}
 };
 
 class PathFinder {
 private:
     const Map* currentMap;
+    SearchContext context;  // 跨查询复用的搜索状态
+    SearchMode searchMode;
+    int trapCost;       // 带权模式下进入陷阱格的成本
+    int maxTraps;       // 带权模式下最多可踩的陷阱数，-1 表示不限制
+    IncrementalPlanner incremental;  // 增量模式的规划器
+    DistanceField goalField;         // 到地图终点的距离场
+    HierarchicalPlanner hierarchy;   // 分层模式的簇抽象
+    Landmarks landmarks;             // ALT 模式的地标距离表
+    CorridorGraph corridors;         // 通道收缩模式的收缩图
+    int lastExpandedCount;
     
 public:
-    PathFinder(const Map* map) : currentMap(map) {}
+    PathFinder(const Map* map)
+        : currentMap(map), searchMode(SEARCH_ASTAR), trapCost(1), maxTraps(-1),
+          incremental(map), goalField(map), hierarchy(map), corridors(map), lastExpandedCount(0) {}
+    
+    // 选择搜索模式
+    void setSearchMode(SearchMode mode) { searchMode = mode; }
+    SearchMode getSearchMode() const { return searchMode; }
+    
+    // 带权模式参数：进入陷阱格的成本（普通格为1）
+    void setTrapCost(int cost);
+    int getTrapCost() const { return trapCost; }
+    
+    // 带权模式的生命值预算：路径上踩到的陷阱不得使生命值降到0
+    // 增量/分层/通道收缩模式得到的路径超出预算时，退回到带预算的完整带权搜索
+    void setHealthBudget(int health, int trapDamage);
+    void clearHealthBudget() { maxTraps = -1; }
     
     // A* 路径查找算法
     std::vector<Position> findPath(const Position& start, const Position& end);
     
+    // 同上，结果写入调用方提供的缓冲区（复用其容量），找到路径返回 true
+    bool findPath(const Position& start, const Position& end, std::vector<Position>& path);
+    
+    // 批量查询：在工作线程池上并行求解，结果按输入顺序返回
+    // 每个线程使用独立的搜索状态，地图在求解期间必须保持不变。
+    // 增量/距离场/分层/通道收缩模式是有状态的，批量求解时改用同样成本模型的带权搜索；
+    // ALT 模式在地标表与地图一致时使用地标表，否则退回 A*。
+    // threadCount 为 0 时使用硬件线程数；lengthsOnly 为 true 时只返回路径长度。
+    std::vector<PathResult> findPaths(const PathQuery* queries, size_t count,
+                                      bool lengthsOnly = false, int threadCount = 0) const;
+    std::vector<PathResult> findPaths(const std::vector<PathQuery>& queries,
+                                      bool lengthsOnly = false, int threadCount = 0) const {
+        return findPaths(queries.data(), queries.size(), lengthsOnly, threadCount);
+    }
+    
     // 获取下一步移动方向
     char getNextMove(const Position& current, const Position& target);
     
+    // 沿终点距离场走一步的方向（O(1)，首次调用时构建距离场），无路可走时返回 ' '
+    char getNextMoveToGoal(const Position& current);
+    
+    // 当前预算下到终点的路径代价（陷阱按 trapCost 计），不可达或距离场未构建时返回 -1
+    int getDistanceToGoal(const Position& pos) const;
+    
+    // 为当前地图构建地标距离表（ALT 模式首次查询时也会自动构建）
+    // 各地标的 BFS 并行计算，threadCount 为 0 时使用硬件线程数
+    void buildLandmarks(int count = Landmarks::DEFAULT_COUNT, int threadCount = 0) {
+        landmarks.build(*currentMap, count, threadCount);
+    }
+    
+    // 读取/保存地标距离表（通常放在地图文件旁，见 Landmarks::sidecarPath），
+    // 读取时校验地图尺寸和内容，不符返回 false
+    bool loadLandmarks(const std::string& path) { return landmarks.load(path, *currentMap); }
+    bool saveLandmarks(const std::string& path) const { return landmarks.save(path); }
+    const Landmarks& getLandmarks() const { return landmarks; }
+    
+    // 最近一次查询扩展的节点数
+    int getLastExpandedCount() const { return lastExpandedCount; }
+    
+    // 分页地图上的 A*：没有连续存储可用，g 值和父节点放在哈希表中，
+    // 内存只与扩展的节点数有关；陷阱格成本为 trapCost。
+    // maxExpanded 为 0 表示不限制，超过上限时放弃并返回 false
+    static bool findPathSparse(const PagedMap& map, const Position& start, const Position& end,
+                               std::vector<Position>& path, int trapCost = 1, size_t maxExpanded = 0);
+    
 private:
+    // 按当前陷阱成本和生命值预算准备好距离场（必要时构建，否则按修改日志局部更新）
+    DistanceField& prepareGoalField();
+    
     // 计算启发式成本（曼哈顿距离）
-    int heuristic(const Position& a, const Position& b);
+    int heuristic(const Position& a, const Position& b) const;
+    
+    // 按搜索模式分派到无状态的搜索算法
+    bool runSearch(SearchContext& ctx, SearchMode mode, int startIndex, int endIndex, int& endState) const;
+    
+    // 在给定的搜索状态上运行 A*，成功时 ctx.parent 中保存路径
+    bool runAStar(SearchContext& ctx, int startIndex, int endIndex) const;
+    
+    // 在给定的搜索状态上运行 ALT（地标距离表必须与当前地图一致）
+    bool runALT(SearchContext& ctx, int startIndex, int endIndex) const;
+    
+    // 在给定的搜索状态上运行带权搜索（桶队列），状态下标为 已踩陷阱数 * 格子数 + 格子下标
+    bool runWeighted(SearchContext& ctx, int startIndex, int endIndex, int& endState) const;
+    
+    // 在给定的搜索状态上运行跳点搜索，ctx.parent 中保存的是跳点链
+    bool runJPS(SearchContext& ctx, int startIndex, int endIndex) const;
+    
+    // 沿水平/垂直方向跳跃，返回找到的跳点下标，遇墙返回 -1
+    int jumpHorizontal(int index, int step, int endIndex) const;
+    int jumpVertical(int index, int step, int endIndex) const;
     
-    // 获取可移动的相邻位置
-    std::vector<Position> getNeighbors(const Position& pos);
+    // 路径步数（不生成路径）
+    int pathLength(const SearchContext& ctx, int endState) const;
     
-    // 重构路径
-    std::vector<Position> reconstructPath(Node* endNode);
+    // 重构路径（相邻的父节点之间按直线补全为逐格路径）
+    // parent 中保存的是状态下标，按格子数取模还原为格子下标
+    void reconstructPath(const SearchContext& ctx, int endState, std::vector<Position>& path) const;
 };
 
-#endif
\ No newline at end of file
+#endif
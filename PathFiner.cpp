@@ -1,96 +1,567 @@
 // PathFinder.cpp
 #include "PathFinder.h"
+#include "PagedMap.h"
 #include <cmath>
 #include <algorithm>
 #include <iostream>
+#include <thread>
+#include <atomic>
+#include <unordered_map>
+#include <queue>
+#include <tuple>
+#include <functional>
 
 using namespace std;
 
 vector<Position> PathFinder::findPath(const Position& start, const Position& end) {
-    // 优先队列用于存储待探索节点
-    priority_queue<Node, vector<Node>, greater<Node>> openSet;
+    vector<Position> path;
+    findPath(start, end, path);
+    return path;
+}
+
+bool PathFinder::findPath(const Position& start, const Position& end, vector<Position>& path) {
+    path.clear();
+    lastExpandedCount = 0;
+    
+    // 起点或终点不可通行时直接返回
+    if (currentMap->getCell(start.x, start.y) == WALL ||
+        currentMap->getCell(end.x, end.y) == WALL) {
+        return false;
+    }
+    
+    // 不在同一连通分量时无需搜索
+    if (!currentMap->isReachable(start, end)) {
+        return false;
+    }
+    
+    int startIndex = currentMap->cellIndex(start.x, start.y);
+    int endIndex = currentMap->cellIndex(end.x, end.y);
+    
+    if (searchMode == SEARCH_INCREMENTAL || searchMode == SEARCH_HIERARCHICAL ||
+        searchMode == SEARCH_CORRIDOR) {
+        bool planned;
+        if (searchMode == SEARCH_INCREMENTAL) {
+            incremental.setTrapCost(trapCost);
+            planned = incremental.plan(start, end, path);
+            lastExpandedCount = incremental.getLastExpandedCount();
+        } else if (searchMode == SEARCH_HIERARCHICAL) {
+            hierarchy.setTrapCost(trapCost);
+            planned = hierarchy.plan(start, end, path);
+            lastExpandedCount = hierarchy.getLastExpandedCount();
+        } else {
+            corridors.setTrapCost(trapCost);
+            planned = corridors.plan(start, end, path);
+            lastExpandedCount = corridors.getLastExpandedCount();
+        }
+        if (!planned) {
+            return false;
+        }
+        
+        int trapsOnPath = 0;
+        for (size_t i = 1; i < path.size(); i++) {
+            if (currentMap->getCell(path[i].x, path[i].y) == TRAP) {
+                trapsOnPath++;
+            }
+        }
+        if (maxTraps < 0 || trapsOnPath <= maxTraps) {
+            return true;
+        }
+        path.clear();  // 超出生命值预算，改用带预算的搜索
+    }
+    
+    if (searchMode == SEARCH_DISTANCE_FIELD && end == currentMap->getEndPosition()) {
+        DistanceField& field = prepareGoalField();
+        return field.extractPath(start, field.layerFor(maxTraps), path);
+    }
+    
+    if (searchMode == SEARCH_ALT && !landmarks.matches(*currentMap)) {
+        landmarks.build(*currentMap);  // 地图变化后距离表不再可采纳，整体重建
+    }
+    
+    int endState = endIndex;
+    bool found = runSearch(context, searchMode, startIndex, endIndex, endState);
+    
+    lastExpandedCount += context.expandedCount;
+    
+    if (!found) {
+        // 没有找到路径
+        return false;
+    }
+    
+    reconstructPath(context, endState, path);
+    return true;
+}
+
+bool PathFinder::runSearch(SearchContext& ctx, SearchMode mode, int startIndex, int endIndex,
+                           int& endState) const {
+    endState = endIndex;
+    switch (mode) {
+        case SEARCH_JPS:
+            return runJPS(ctx, startIndex, endIndex);
+        case SEARCH_ALT:
+            if (landmarks.matches(*currentMap)) {
+                return runALT(ctx, startIndex, endIndex);
+            }
+            return runAStar(ctx, startIndex, endIndex);
+        case SEARCH_WEIGHTED:
+        case SEARCH_INCREMENTAL:
+        case SEARCH_DISTANCE_FIELD:
+        case SEARCH_HIERARCHICAL:
+        case SEARCH_CORRIDOR:
+            return runWeighted(ctx, startIndex, endIndex, endState);
+        default:
+            return runAStar(ctx, startIndex, endIndex);
+    }
+}
+
+vector<PathResult> PathFinder::findPaths(const PathQuery* queries, size_t count,
+                                         bool lengthsOnly, int threadCount) const {
+    vector<PathResult> results(count);
+    if (count == 0) {
+        return results;
+    }
+    
+    // 先在调用线程上构建并压缩连通分量索引，之后各线程的查询只读
+    currentMap->buildComponents();
+    
+    if (threadCount <= 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+    threadCount = static_cast<int>(min<size_t>(threadCount, count));
+    
+    // 各线程按小块领取查询，结果写回对应下标
+    const size_t chunkSize = 16;
+    atomic<size_t> nextQuery(0);
+    auto worker = [&]() {
+        SearchContext ctx;
+        while (true) {
+            size_t begin = nextQuery.fetch_add(chunkSize);
+            if (begin >= count) {
+                break;
+            }
+            size_t end = min(begin + chunkSize, count);
+            for (size_t i = begin; i < end; i++) {
+                const PathQuery& query = queries[i];
+                PathResult& result = results[i];
+                if (currentMap->getCell(query.start.x, query.start.y) == WALL ||
+                    currentMap->getCell(query.end.x, query.end.y) == WALL ||
+                    !currentMap->isReachable(query.start, query.end)) {
+                    continue;
+                }
+                
+                int startIndex = currentMap->cellIndex(query.start.x, query.start.y);
+                int endIndex = currentMap->cellIndex(query.end.x, query.end.y);
+                int endState = endIndex;
+                if (!runSearch(ctx, searchMode, startIndex, endIndex, endState)) {
+                    continue;
+                }
+                
+                result.found = true;
+                if (lengthsOnly) {
+                    result.length = pathLength(ctx, endState);
+                } else {
+                    reconstructPath(ctx, endState, result.path);
+                    result.length = static_cast<int>(result.path.size()) - 1;
+                }
+            }
+        }
+    };
+    
+    vector<thread> workers;
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(worker);
+    }
+    worker();  // 调用线程也参与求解
+    for (thread& t : workers) {
+        t.join();
+    }
     
-    // 用于记录每个位置的最佳成本
-    unordered_map<int, unordered_map<int, int>> bestCosts;
+    return results;
+}
+
+void PathFinder::setTrapCost(int cost) {
+    // 成本决定桶队列的桶数，限制在合理范围内
+    trapCost = max(1, min(cost, 1000));
+}
+
+void PathFinder::setHealthBudget(int health, int trapDamage) {
+    if (trapDamage <= 0) {
+        maxTraps = -1;
+    } else {
+        maxTraps = health > 0 ? (health - 1) / trapDamage : -1;
+    }
+}
+
+bool PathFinder::runAStar(SearchContext& ctx, int startIndex, int endIndex) const {
+    ctx.prepare(currentMap->getCellCount());
+    
+    const uint8_t* cells = currentMap->data();
+    int stride = currentMap->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    Position end = currentMap->indexToPosition(endIndex);
     
     // 创建起始节点
-    Node startNode(start, 0, heuristic(start, end));
-    openSet.push(startNode);
-    bestCosts[start.y][start.x] = 0;
+    ctx.visit(startIndex, 0, -1);
+    ctx.push(Node(startIndex, 0, heuristic(currentMap->indexToPosition(startIndex), end)));
     
-    while (!openSet.empty()) {
+    while (!ctx.empty()) {
         // 获取当前最佳节点
-        Node current = openSet.top();
-        openSet.pop();
+        Node current = ctx.pop();
+        
+        // 已经有更优的路径到达该节点，跳过过期条目
+        if (current.gCost > ctx.gCost[current.index]) {
+            continue;
+        }
+        ctx.expandedCount++;
         
-        // 如果到达终点，重构路径
-        if (current.pos == end) {
-            return reconstructPath(&current);
+        // 如果到达终点
+        if (current.index == endIndex) {
+            return true;
         }
         
-        // 检查所有相邻位置
-        for (const Position& neighborPos : getNeighbors(current.pos)) {
+        // 检查所有相邻位置（边框为墙壁，无需边界检查）
+        for (int i = 0; i < 4; i++) {
+            int neighbor = current.index + offsets[i];
+            if (cells[neighbor] == WALL) {
+                continue;
+            }
+            
             int newGCost = current.gCost + 1;  // 每步成本为1
             
             // 检查是否找到更优路径
-            if (bestCosts[neighborPos.y].count(neighborPos.x) == 0 || 
-                newGCost < bestCosts[neighborPos.y][neighborPos.x]) {
-                
-                bestCosts[neighborPos.y][neighborPos.x] = newGCost;
-                int hCost = heuristic(neighborPos, end);
-                
-                Node neighborNode(neighborPos, newGCost, hCost, new Node(current));
-                openSet.push(neighborNode);
+            if (!ctx.isVisited(neighbor) || newGCost < ctx.gCost[neighbor]) {
+                ctx.visit(neighbor, newGCost, current.index);
+                int hCost = heuristic(currentMap->indexToPosition(neighbor), end);
+                ctx.push(Node(neighbor, newGCost, hCost));
             }
         }
     }
     
-    // 没有找到路径
-    return vector<Position>();
+    return false;
 }
 
-vector<Position> PathFinder::reconstructPath(Node* endNode) {
-    vector<Position> path;
-    Node* current = endNode;
+bool PathFinder::runALT(SearchContext& ctx, int startIndex, int endIndex) const {
+    ctx.prepare(currentMap->getCellCount());
     
-    while (current != nullptr) {
-        path.push_back(current->pos);
-        current = current->parent;
+    const uint8_t* cells = currentMap->data();
+    int stride = currentMap->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    Position end = currentMap->indexToPosition(endIndex);
+    
+    // 活跃地标：只保留对起点给出最大下界的几个，每个节点只需查这几张表
+    const int MAX_ACTIVE = 4;
+    int active[Landmarks::MAX_COUNT];
+    int goalDist[Landmarks::MAX_COUNT];
+    int bound[Landmarks::MAX_COUNT];
+    int activeCount = 0;
+    for (int k = 0; k < landmarks.getCount(); k++) {
+        uint32_t toGoal = landmarks.distance(k, endIndex);
+        uint32_t toStart = landmarks.distance(k, startIndex);
+        if (toGoal == Landmarks::UNREACHABLE || toStart == Landmarks::UNREACHABLE) {
+            continue;  // 地标与起终点不连通，给不出下界
+        }
+        active[activeCount] = k;
+        goalDist[activeCount] = static_cast<int>(toGoal);
+        bound[activeCount] = abs(static_cast<int>(toGoal) - static_cast<int>(toStart));
+        activeCount++;
     }
+    // 按起点处的下界从大到小排序（最多16个，插入排序即可）
+    for (int i = 1; i < activeCount; i++) {
+        for (int j = i; j > 0 && bound[j] > bound[j - 1]; j--) {
+            swap(bound[j], bound[j - 1]);
+            swap(active[j], active[j - 1]);
+            swap(goalDist[j], goalDist[j - 1]);
+        }
+    }
+    activeCount = min(activeCount, MAX_ACTIVE);
     
-    reverse(path.begin(), path.end());
-    return path;
+    // 各个下界都一致，取最大值仍然一致
+    auto altHeuristic = [&](int index) {
+        int h = heuristic(currentMap->indexToPosition(index), end);
+        for (int i = 0; i < activeCount; i++) {
+            int d = static_cast<int>(landmarks.distance(active[i], index));
+            h = max(h, abs(goalDist[i] - d));
+        }
+        return h;
+    };
+    
+    ctx.visit(startIndex, 0, -1);
+    ctx.push(Node(startIndex, 0, altHeuristic(startIndex)));
+    
+    while (!ctx.empty()) {
+        Node current = ctx.pop();
+        
+        if (current.gCost > ctx.gCost[current.index]) {
+            continue;
+        }
+        ctx.expandedCount++;
+        
+        if (current.index == endIndex) {
+            return true;
+        }
+        
+        for (int i = 0; i < 4; i++) {
+            int neighbor = current.index + offsets[i];
+            if (cells[neighbor] == WALL) {
+                continue;
+            }
+            
+            int newGCost = current.gCost + 1;
+            if (!ctx.isVisited(neighbor) || newGCost < ctx.gCost[neighbor]) {
+                ctx.visit(neighbor, newGCost, current.index);
+                ctx.push(Node(neighbor, newGCost, altHeuristic(neighbor)));
+            }
+        }
+    }
+    
+    return false;
 }
 
-int PathFinder::heuristic(const Position& a, const Position& b) {
-    // 使用曼哈顿距离
-    return abs(a.x - b.x) + abs(a.y - b.y);
+bool PathFinder::runWeighted(SearchContext& ctx, int startIndex, int endIndex, int& endState) const {
+    // 启用生命值预算时按已踩陷阱数分层，每层一份完整的格子状态
+    // 层数过多时收紧预算，避免状态下标溢出
+    int cellCount = currentMap->getCellCount();
+    int layers = maxTraps >= 0 ? SearchContext::clampLayers(cellCount, maxTraps + 1) : 1;
+    int trapLimit = maxTraps >= 0 ? layers - 1 : -1;
+    ctx.prepare(cellCount * layers);
+    
+    const uint8_t* cells = currentMap->data();
+    int stride = currentMap->getStride();
+    const int offsets[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    Position end = currentMap->indexToPosition(endIndex);
+    
+    // 曼哈顿启发一致，每步 f 值的增量在 [0, trapCost + 1] 之间
+    int startH = heuristic(currentMap->indexToPosition(startIndex), end);
+    ctx.buckets.reset(trapCost + 1, startH);
+    
+    ctx.visit(startIndex, 0, -1);
+    ctx.buckets.push(startH, Node(startIndex, 0, startH));
+    
+    while (!ctx.buckets.empty()) {
+        Node current = ctx.buckets.pop();
+        
+        if (current.gCost > ctx.gCost[current.index]) {
+            continue;
+        }
+        ctx.expandedCount++;
+        
+        int cell = current.index % cellCount;
+        int layer = current.index / cellCount;
+        
+        if (cell == endIndex) {
+            endState = current.index;
+            return true;
+        }
+        
+        for (int i = 0; i < 4; i++) {
+            int neighbor = cell + offsets[i];
+            uint8_t type = cells[neighbor];
+            if (type == WALL) {
+                continue;
+            }
+            
+            int stepCost = 1;
+            int neighborLayer = layer;
+            if (type == TRAP) {
+                stepCost = trapCost;
+                if (trapLimit >= 0) {
+                    if (layer >= trapLimit) {
+                        continue;  // 再踩一个陷阱就会耗尽生命值
+                    }
+                    neighborLayer = layer + 1;
+                }
+            }
+            
+            int state = neighborLayer * cellCount + neighbor;
+            int newGCost = current.gCost + stepCost;
+            
+            if (!ctx.isVisited(state) || newGCost < ctx.gCost[state]) {
+                ctx.visit(state, newGCost, current.index);
+                int hCost = heuristic(currentMap->indexToPosition(neighbor), end);
+                ctx.buckets.push(newGCost + hCost, Node(state, newGCost, hCost));
+            }
+        }
+    }
+    
+    return false;
 }
 
-vector<Position> PathFinder::getNeighbors(const Position& pos) {
-    vector<Position> neighbors;
+bool PathFinder::runJPS(SearchContext& ctx, int startIndex, int endIndex) const {
+    ctx.prepare(currentMap->getCellCount());
     
-    // 四个方向的移动
-    vector<Position> directions = {
-        Position(0, -1),  // 上
-        Position(1, 0),   // 右
-        Position(0, 1),   // 下
-        Position(-1, 0)   // 左
-    };
+    int stride = currentMap->getStride();
+    const int directions[] = {-stride, 1, stride, -1};  // 上、右、下、左
+    Position end = currentMap->indexToPosition(endIndex);
+    
+    ctx.visit(startIndex, 0, -1);
+    ctx.push(Node(startIndex, 0, heuristic(currentMap->indexToPosition(startIndex), end)));
     
-    for (const Position& dir : directions) {
-        Position newPos(pos.x + dir.x, pos.y + dir.y);
+    while (!ctx.empty()) {
+        Node current = ctx.pop();
+        
+        if (current.gCost > ctx.gCost[current.index]) {
+            continue;
+        }
+        ctx.expandedCount++;
+        
+        if (current.index == endIndex) {
+            return true;
+        }
+        
+        // 根据来向剪枝：水平移动时继续前进并尝试上下两个方向，
+        // 垂直移动时继续前进并尝试左右两个方向；起点尝试全部四个方向
+        int parentIndex = ctx.parent[current.index];
+        int incoming = 0;
+        if (parentIndex != -1) {
+            int delta = current.index - parentIndex;
+            if (delta % stride == 0) {
+                incoming = delta > 0 ? stride : -stride;
+            } else {
+                incoming = delta > 0 ? 1 : -1;
+            }
+        }
         
-        // 检查位置是否有效且可通行
-        if (currentMap->isValidPosition(newPos.x, newPos.y)) {
-            CellType cellType = currentMap->getCell(newPos.x, newPos.y);
-            if (cellType != WALL) {  // 墙壁不可通行
-                neighbors.push_back(newPos);
+        for (int i = 0; i < 4; i++) {
+            int step = directions[i];
+            if (step == -incoming) {
+                continue;  // 不走回头路
+            }
+            
+            bool vertical = (step == stride || step == -stride);
+            int jumpPoint = vertical ? jumpVertical(current.index, step, endIndex)
+                                     : jumpHorizontal(current.index, step, endIndex);
+            if (jumpPoint == -1) {
+                continue;
+            }
+            
+            // 跳点与当前节点在同一直线上，距离即为格数
+            int distance = (jumpPoint - current.index) / step;
+            int newGCost = current.gCost + distance;
+            
+            if (!ctx.isVisited(jumpPoint) || newGCost < ctx.gCost[jumpPoint]) {
+                ctx.visit(jumpPoint, newGCost, current.index);
+                int hCost = heuristic(currentMap->indexToPosition(jumpPoint), end);
+                ctx.push(Node(jumpPoint, newGCost, hCost));
             }
         }
     }
     
-    return neighbors;
+    return false;
+}
+
+int PathFinder::jumpHorizontal(int index, int step, int endIndex) const {
+    const uint8_t* cells = currentMap->data();
+    int stride = currentMap->getStride();
+    
+    while (true) {
+        index += step;
+        if (cells[index] == WALL) {
+            return -1;
+        }
+        if (index == endIndex) {
+            return index;
+        }
+        
+        // 强制邻居：上方/下方可通行，而身后对应的格子被墙挡住
+        if ((cells[index - stride] != WALL && cells[index - step - stride] == WALL) ||
+            (cells[index + stride] != WALL && cells[index - step + stride] == WALL)) {
+            return index;
+        }
+    }
+}
+
+int PathFinder::jumpVertical(int index, int step, int endIndex) const {
+    const uint8_t* cells = currentMap->data();
+    
+    while (true) {
+        index += step;
+        if (cells[index] == WALL) {
+            return -1;
+        }
+        if (index == endIndex) {
+            return index;
+        }
+        
+        // 强制邻居：左侧/右侧可通行，而身后对应的格子被墙挡住
+        if ((cells[index - 1] != WALL && cells[index - 1 - step] == WALL) ||
+            (cells[index + 1] != WALL && cells[index + 1 - step] == WALL)) {
+            return index;
+        }
+        
+        // 垂直移动时，若水平方向上能找到跳点，则当前格子也是跳点
+        if (jumpHorizontal(index, 1, endIndex) != -1 ||
+            jumpHorizontal(index, -1, endIndex) != -1) {
+            return index;
+        }
+    }
+}
+
+int PathFinder::pathLength(const SearchContext& ctx, int endState) const {
+    // 跳点搜索的父子节点位于同一直线上，按格数累加
+    int stride = currentMap->getStride();
+    int cellCount = currentMap->getCellCount();
+    int length = 0;
+    for (int state = endState; ctx.parent[state] != -1; state = ctx.parent[state]) {
+        int delta = abs(state % cellCount - ctx.parent[state] % cellCount);
+        length += (delta % stride == 0) ? delta / stride : delta;
+    }
+    return length;
+}
+
+void PathFinder::reconstructPath(const SearchContext& ctx, int endState, vector<Position>& path) const {
+    // 先数出路径长度，再从后往前填充，避免反转和额外分配
+    // 跳点搜索的父子节点之间逐格补全
+    int stride = currentMap->getStride();
+    int cellCount = currentMap->getCellCount();
+    size_t length = pathLength(ctx, endState) + 1;
+    
+    path.resize(length);
+    path[--length] = currentMap->indexToPosition(endState % cellCount);
+    for (int state = endState; ctx.parent[state] != -1; state = ctx.parent[state]) {
+        int index = state % cellCount;
+        int parentIndex = ctx.parent[state] % cellCount;
+        int delta = index - parentIndex;
+        int step = (delta % stride == 0) ? (delta > 0 ? stride : -stride) : (delta > 0 ? 1 : -1);
+        for (int cell = index - step; ; cell -= step) {
+            path[--length] = currentMap->indexToPosition(cell);
+            if (cell == parentIndex) break;
+        }
+    }
+}
+
+int PathFinder::heuristic(const Position& a, const Position& b) const {
+    // 使用曼哈顿距离
+    return abs(a.x - b.x) + abs(a.y - b.y);
+}
+
+DistanceField& PathFinder::prepareGoalField() {
+    Position goal = currentMap->getEndPosition();
+    if (goalField.matches(goal, trapCost, maxTraps)) {
+        goalField.update();
+    } else {
+        goalField.build(goal, trapCost, maxTraps);
+    }
+    return goalField;
+}
+
+char PathFinder::getNextMoveToGoal(const Position& current) {
+    if (currentMap->getCell(current.x, current.y) == WALL) {
+        return ' ';
+    }
+    DistanceField& field = prepareGoalField();
+    int layer = field.layerFor(maxTraps);
+    int next = field.nextCell(currentMap->cellIndex(current.x, current.y), layer);
+    if (next == -1 || current == currentMap->getEndPosition()) {
+        return ' ';
+    }
+    return getNextMove(current, currentMap->indexToPosition(next));
+}
+
+int PathFinder::getDistanceToGoal(const Position& pos) const {
+    if (!goalField.isBuilt()) {
+        return -1;
+    }
+    return goalField.getDistance(pos, goalField.layerFor(maxTraps));
 }
 
 char PathFinder::getNextMove(const Position& current, const Position& target) {
@@ -99,4 +570,75 @@ char PathFinder::getNextMove(const Position& current, const Position& target) {
     if (target.y > current.y) return 's';  // 下
     if (target.y < current.y) return 'w';  // 上
     return ' ';  // 相同位置
-}
\ No newline at end of file
+}
+
+bool PathFinder::findPathSparse(const PagedMap& map, const Position& start, const Position& end,
+                                vector<Position>& path, int trapCost, size_t maxExpanded) {
+    path.clear();
+    if (map.getCell(start.x, start.y) == WALL || map.getCell(end.x, end.y) == WALL) {
+        return false;
+    }
+    trapCost = max(1, trapCost);
+    
+    // 格子键 = y * width + x（64 位，支持超大地图）
+    struct SparseNode {
+        int gCost;
+        int64_t parent;
+    };
+    const int64_t width = map.getWidth();
+    auto keyOf = [width](int x, int y) { return static_cast<int64_t>(y) * width + x; };
+    auto manhattan = [&end](int x, int y) { return abs(x - end.x) + abs(y - end.y); };
+    
+    unordered_map<int64_t, SparseNode> nodes;
+    // 堆元素 (f, -g, 键)：f 相同时优先 g 大的节点
+    typedef tuple<int, int, int64_t> Entry;
+    priority_queue<Entry, vector<Entry>, greater<Entry>> open;
+    
+    int64_t startKey = keyOf(start.x, start.y);
+    int64_t endKey = keyOf(end.x, end.y);
+    nodes[startKey] = {0, -1};
+    open.emplace(manhattan(start.x, start.y), 0, startKey);
+    
+    const int dx[] = {0, 1, 0, -1};
+    const int dy[] = {-1, 0, 1, 0};
+    size_t expanded = 0;
+    
+    while (!open.empty()) {
+        int g = -get<1>(open.top());
+        int64_t key = get<2>(open.top());
+        open.pop();
+        
+        if (g > nodes[key].gCost) {
+            continue;  // 过期条目
+        }
+        if (key == endKey) {
+            // 沿父节点回溯
+            for (int64_t k = endKey; k != -1; k = nodes[k].parent) {
+                path.push_back(Position(static_cast<int>(k % width), static_cast<int>(k / width)));
+            }
+            reverse(path.begin(), path.end());
+            return true;
+        }
+        if (maxExpanded != 0 && ++expanded > maxExpanded) {
+            return false;
+        }
+        
+        int x = static_cast<int>(key % width);
+        int y = static_cast<int>(key / width);
+        for (int i = 0; i < 4; i++) {
+            int nx = x + dx[i], ny = y + dy[i];
+            CellType type = map.getCell(nx, ny);
+            if (type == WALL) {
+                continue;
+            }
+            int newGCost = g + (type == TRAP ? trapCost : 1);
+            int64_t neighbor = keyOf(nx, ny);
+            auto it = nodes.find(neighbor);
+            if (it == nodes.end() || newGCost < it->second.gCost) {
+                nodes[neighbor] = {newGCost, key};
+                open.emplace(newGCost + manhattan(nx, ny), -newGCost, neighbor);
+            }
+        }
+    }
+    return false;
+}
@@ -2,8 +2,9 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
-#include "position.h"
+#include "Position.h"
 
+class Map;
 
 class Player {
 private:
@@ -0,0 +1,158 @@
+// Reachability.cpp
+#include "Reachability.h"
+#include <algorithm>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+using namespace std;
+
+void Reachability::buildPassable(const Map& map, BitGrid& passable) {
+    int width = map.getWidth();
+    int height = map.getHeight();
+    passable.resize(width, height);
+
+    for (int y = 0; y < height; y++) {
+        const uint8_t* cells = map.row(y);
+        uint64_t* bits = passable.row(y);
+        int x = 0;
+
+#if defined(__SSE2__)
+        // 每次比较16个字节，movemask 直接得到16位的墙壁掩码
+        const __m128i wall = _mm_set1_epi8(static_cast<char>(WALL));
+        for (; x + 16 <= width; x += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cells + x));
+            uint32_t walls = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, wall)));
+            uint64_t open = (~walls) & 0xFFFFu;
+            bits[x >> 6] |= open << (x & 63);
+        }
+#endif
+        for (; x < width; x++) {
+            if (cells[x] != WALL) {
+                bits[x >> 6] |= uint64_t(1) << (x & 63);
+            }
+        }
+    }
+}
+
+void Reachability::fillRow(uint64_t* reach, const uint64_t* pass, int wordCount) {
+    // 向高位（x 增大方向）扩散：Kogge-Stone 被遮挡填充，进位传到下一个字
+    uint64_t carry = 0;
+    for (int w = 0; w < wordCount; w++) {
+        uint64_t g = reach[w] | (carry & pass[w]);
+        uint64_t p = pass[w];
+        g |= p & (g << 1);  p &= p << 1;
+        g |= p & (g << 2);  p &= p << 2;
+        g |= p & (g << 4);  p &= p << 4;
+        g |= p & (g << 8);  p &= p << 8;
+        g |= p & (g << 16); p &= p << 16;
+        g |= p & (g << 32);
+        reach[w] = g;
+        carry = g >> 63;
+    }
+
+    // 向低位（x 减小方向）扩散
+    carry = 0;
+    for (int w = wordCount - 1; w >= 0; w--) {
+        uint64_t g = reach[w] | ((carry << 63) & pass[w]);
+        uint64_t p = pass[w];
+        g |= p & (g >> 1);  p &= p >> 1;
+        g |= p & (g >> 2);  p &= p >> 2;
+        g |= p & (g >> 4);  p &= p >> 4;
+        g |= p & (g >> 8);  p &= p >> 8;
+        g |= p & (g >> 16); p &= p >> 16;
+        g |= p & (g >> 32);
+        reach[w] = g;
+        carry = g & 1;
+    }
+}
+
+bool Reachability::mergeRows(uint64_t* reach, const uint64_t* above, const uint64_t* below,
+                             const uint64_t* pass, int wordCount) {
+    // 新前沿 = (上一行 | 下一行) & 本行可通行 & ~本行已到达
+    int w = 0;
+    bool changed = false;
+
+#if defined(__SSE2__)
+    __m128i anyNew = _mm_setzero_si128();
+    for (; w + 2 <= wordCount; w += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + w));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(below + w));
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pass + w));
+        __m128i r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(reach + w));
+        __m128i fresh = _mm_andnot_si128(r, _mm_and_si128(_mm_or_si128(a, b), p));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(reach + w), _mm_or_si128(r, fresh));
+        anyNew = _mm_or_si128(anyNew, fresh);
+    }
+    changed = _mm_movemask_epi8(_mm_cmpeq_epi8(anyNew, _mm_setzero_si128())) != 0xFFFF;
+#endif
+
+    for (; w < wordCount; w++) {
+        uint64_t fresh = (above[w] | below[w]) & pass[w] & ~reach[w];
+        reach[w] |= fresh;
+        changed |= (fresh != 0);
+    }
+    return changed;
+}
+
+bool Reachability::floodFill(const Map& map, const Position& start, const Position& target,
+                             BitGrid* reached) {
+    int width = map.getWidth();
+    int height = map.getHeight();
+
+    BitGrid localReach;
+    BitGrid& reach = reached ? *reached : localReach;
+    reach.resize(width, height);
+
+    if (map.getCell(start.x, start.y) == WALL) {
+        return false;
+    }
+
+    BitGrid passable;
+    buildPassable(map, passable);
+
+    int wordCount = passable.getWordsPerRow();
+    bool targetValid = map.isValidPosition(target.x, target.y);
+    bool stopEarly = (reached == nullptr);
+    vector<uint64_t> emptyRow(wordCount, 0);
+
+    // 待处理行的工作栈：某行有新增格子时，其上下两行需要重新合并
+    vector<int> pending;
+    vector<uint8_t> queued(height, 0);
+
+    reach.set(start.x, start.y);
+    fillRow(reach.row(start.y), passable.row(start.y), wordCount);
+    for (int ny : {start.y - 1, start.y + 1}) {
+        if (ny >= 0 && ny < height) {
+            pending.push_back(ny);
+            queued[ny] = 1;
+        }
+    }
+
+    while (!pending.empty()) {
+        if (stopEarly && targetValid && reach.get(target.x, target.y)) {
+            return true;
+        }
+
+        int y = pending.back();
+        pending.pop_back();
+        queued[y] = 0;
+
+        const uint64_t* above = y > 0 ? reach.row(y - 1) : emptyRow.data();
+        const uint64_t* below = y + 1 < height ? reach.row(y + 1) : emptyRow.data();
+        if (!mergeRows(reach.row(y), above, below, passable.row(y), wordCount)) {
+            continue;
+        }
+        fillRow(reach.row(y), passable.row(y), wordCount);
+
+        for (int ny : {y - 1, y + 1}) {
+            if (ny >= 0 && ny < height && !queued[ny]) {
+                pending.push_back(ny);
+                queued[ny] = 1;
+            }
+        }
+    }
+
+    return targetValid && reach.get(target.x, target.y);
+}
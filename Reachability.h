@@ -0,0 +1,33 @@
+// Reachability.h
+#ifndef REACHABILITY_H
+#define REACHABILITY_H
+
+#include "Map.h"
+#include "Position.h"
+#include "BitGrid.h"
+#include <vector>
+#include <cstdint>
+
+// 位并行连通性检测
+// 将可通行格子打包成位图，以整行为单位推进：行内用移位/与/或沿连续可通行段扩散，
+// 行间用相邻行的按位或合并新的前沿（支持时使用 SSE2 一次处理两个字）。
+class Reachability {
+public:
+    // 从 start 出发能否到达 target
+    // reached 非空时不会提前结束，并输出从 start 出发可到达的全部格子
+    static bool floodFill(const Map& map, const Position& start, const Position& target,
+                          BitGrid* reached = nullptr);
+
+    // 将地图中的非墙壁格子打包为位图
+    static void buildPassable(const Map& map, BitGrid& passable);
+
+private:
+    // 行内沿可通行段向两侧扩散（跨越字边界）
+    static void fillRow(uint64_t* reach, const uint64_t* pass, int wordCount);
+
+    // 从上下两行合并新到达的格子，返回本行是否有新增
+    static bool mergeRows(uint64_t* reach, const uint64_t* above, const uint64_t* below,
+                          const uint64_t* pass, int wordCount);
+};
+
+#endif
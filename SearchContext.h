@@ -0,0 +1,92 @@
+// SearchContext.h
+#ifndef SEARCHCONTEXT_H
+#define SEARCHCONTEXT_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include "BucketQueue.h"
+
+// 开放列表中的节点（只记录地图线性下标，父节点存放在 SearchContext::parent 中）
+struct Node {
+    int index;  // 地图线性下标（含边框）
+    int gCost;  // 从起点到当前节点的成本
+    int hCost;  // 到终点的预估成本
+    int fCost() const { return gCost + hCost; }
+    
+    Node(int i = 0, int g = 0, int h = 0) : index(i), gCost(g), hCost(h) {}
+    
+    bool operator>(const Node& other) const {
+        if (fCost() != other.fCost()) return fCost() > other.fCost();
+        return gCost < other.gCost;  // f相同时优先扩展更深的节点
+    }
+};
+
+// 可复用的搜索状态
+// 成本/父节点数组按地图大小稠密分配，用代号（generation）标记本轮写入过的格子，
+// 因此两次查询之间无需清空数组；开放列表的容量也会保留下来。
+// 预热之后重复查询不再产生堆分配。
+class SearchContext {
+public:
+    std::vector<int> gCost;
+    std::vector<int> parent;
+    std::vector<uint32_t> stamp;
+    std::vector<Node> openList;  // 二叉小顶堆
+    BucketQueue<Node> buckets;   // 整数权重搜索使用的桶队列
+    uint32_t generation;
+    int expandedCount;  // 本轮扩展的节点数
+    
+    // 按已踩陷阱数分层的搜索，状态下标 = 层 * 格子数 + 格子，用 int 存放
+    static constexpr int MAX_LAYERED_STATES = 1 << 26;  // 约 800MB 的搜索状态
+    
+    SearchContext() : generation(0), expandedCount(0) {}
+    
+    // 分层搜索实际可用的层数：状态总数超过 MAX_LAYERED_STATES 时减少层数（至少1层）。
+    // 层数变少相当于允许踩的陷阱变少，找到的路径仍在生命值预算之内
+    static int clampLayers(int cellCount, int layers) {
+        int64_t limit = MAX_LAYERED_STATES / std::max(cellCount, 1);
+        return static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(layers, limit)));
+    }
+    
+    // 开始新一轮搜索
+    void prepare(int cellCount) {
+        if (static_cast<int>(stamp.size()) != cellCount) {
+            gCost.assign(cellCount, 0);
+            parent.assign(cellCount, -1);
+            stamp.assign(cellCount, 0);
+            generation = 0;
+        }
+        if (++generation == 0) {  // 代号回绕，清空一次
+            std::fill(stamp.begin(), stamp.end(), 0);
+            generation = 1;
+        }
+        openList.clear();
+        expandedCount = 0;
+    }
+    
+    bool isVisited(int index) const { return stamp[index] == generation; }
+    
+    void visit(int index, int g, int parentIndex) {
+        stamp[index] = generation;
+        gCost[index] = g;
+        parent[index] = parentIndex;
+    }
+    
+    // 开放列表操作
+    void push(const Node& node) {
+        openList.push_back(node);
+        std::push_heap(openList.begin(), openList.end(), std::greater<Node>());
+    }
+    
+    Node pop() {
+        std::pop_heap(openList.begin(), openList.end(), std::greater<Node>());
+        Node node = openList.back();
+        openList.pop_back();
+        return node;
+    }
+    
+    bool empty() const { return openList.empty(); }
+};
+
+#endif
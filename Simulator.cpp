@@ -0,0 +1,107 @@
+// Simulator.cpp
+#include "Simulator.h"
+#include <chrono>
+
+using namespace std;
+using namespace std::chrono;
+
+// xorshift32：足够用于随机游走，且各平台结果一致
+static unsigned nextRandom(unsigned& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+SimulationStats Simulator::run(const Map& map, const SimulationOptions& options) {
+    SimulationStats stats;
+    unsigned rng = options.seed ? options.seed : 1;
+    
+    auto startTime = steady_clock::now();
+    for (int i = 0; i < options.games; i++) {
+        // 每局使用新的地图副本，陷阱不会被上一局消耗
+        GameSession session(map, options.fogMode, options.autoMode, options.visionMode);
+        int steps = 0;
+        GameStatus result = playOne(session, options, rng, steps);
+        
+        stats.steps += steps;
+        if (result == GAME_WON) {
+            stats.wins++;
+        } else if (result == GAME_LOST) {
+            stats.losses++;
+        } else {
+            stats.timeouts++;
+        }
+    }
+    stats.elapsedMs = duration<double, milli>(steady_clock::now() - startTime).count();
+    
+    return stats;
+}
+
+GameStatus Simulator::playOne(GameSession& session, const SimulationOptions& options,
+                              unsigned& rng, int& steps) {
+    static const char directions[] = {'w', 'a', 's', 'd'};
+    steps = 0;
+    
+    if (options.autoMode && !session.planPath()) {
+        return session.getStatus();  // 无路可走，记为超时
+    }
+    
+    // 按回合计数而不是按成功移动计数：撞墙也消耗回合，被困时不会死循环
+    for (int turn = 0; turn < options.maxSteps && !session.isOver(); turn++) {
+        int events;
+        if (options.autoMode) {
+            events = session.stepAuto();
+            if (events & EVENT_BLOCKED) {
+                break;
+            }
+        } else {
+            events = session.applyMove(directions[nextRandom(rng) & 3]);
+        }
+        if (events & EVENT_MOVED) {
+            steps++;
+        }
+    }
+    
+    return session.getStatus();
+}
+
+SimulationStats Simulator::replay(const Map& map, const SimulationOptions& options,
+                                  KeyReader& input, long long& keyCount) {
+    SimulationStats stats;
+    keyCount = 0;
+    
+    auto startTime = steady_clock::now();
+    GameSession session(map, options.fogMode, false, options.visionMode);
+    
+    // 与 playOne 相同按回合计数：撞墙也算一个回合
+    char key;
+    int turns = 0;
+    while (!session.isOver() && turns < options.maxSteps && input.wait(key)) {
+        keyCount++;
+        if (key == 'q' || key == 'Q') {
+            break;
+        }
+        switch (key) {
+            case 'w': case 'a': case 's': case 'd':
+            case 'W': case 'A': case 'S': case 'D':
+                break;
+            default:
+                continue;  // 换行、空格等分隔符
+        }
+        if (session.applyMove(key) & EVENT_MOVED) {
+            stats.steps++;
+        }
+        turns++;
+    }
+    stats.elapsedMs = duration<double, milli>(steady_clock::now() - startTime).count();
+    
+    if (session.getStatus() == GAME_WON) {
+        stats.wins = 1;
+    } else if (session.getStatus() == GAME_LOST) {
+        stats.losses = 1;
+    } else {
+        stats.timeouts = 1;
+    }
+    return stats;
+}
@@ -0,0 +1,51 @@
+// Simulator.h
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "Map.h"
+#include "GameSession.h"
+#include "Terminal.h"
+
+// 无界面模拟的参数
+struct SimulationOptions {
+    int games;          // 对局数
+    unsigned seed;      // 随机种子（手动模式下随机游走使用）
+    bool autoMode;      // true: 自动寻路；false: 随机按 WASD
+    bool fogMode;
+    VisionMode visionMode;  // 迷雾模式下的视野计算方式
+    int maxSteps;       // 单局最多回合数，超出记为超时
+    
+    SimulationOptions()
+        : games(1), seed(1), autoMode(true), fogMode(false), visionMode(VISION_RADIUS),
+          maxSteps(10000) {}
+};
+
+// 模拟结果汇总
+struct SimulationStats {
+    int wins;
+    int losses;
+    int timeouts;
+    long long steps;        // 所有对局的总步数
+    double elapsedMs;
+    
+    SimulationStats() : wins(0), losses(0), timeouts(0), steps(0), elapsedMs(0) {}
+};
+
+// 无界面模拟器
+// 直接驱动 GameSession，不清屏、不等待按键、不休眠，
+// 用于批量跑对局、测量性能或在没有终端的环境下验证规则。
+class Simulator {
+public:
+    static SimulationStats run(const Map& map, const SimulationOptions& options);
+    
+    // 跑一局，返回结束状态；steps 输出本局步数
+    static GameStatus playOne(GameSession& session, const SimulationOptions& options,
+                              unsigned& rng, int& steps);
+    
+    // 回放按键脚本：从 input 读取 WASD（大小写均可）逐个执行，其余字符忽略，Q 结束回放。
+    // 只跑一局，不渲染、不延迟；输入读完时对局仍未结束记为超时。keyCount 输出读到的字节数
+    static SimulationStats replay(const Map& map, const SimulationOptions& options,
+                                  KeyReader& input, long long& keyCount);
+};
+
+#endif
@@ -0,0 +1,211 @@
+// Terminal.cpp
+#include "Terminal.h"
+#include <cstdlib>
+#include <csignal>
+
+#ifdef _WIN32
+    #include <conio.h>
+#else
+    #include <termios.h>
+    #include <unistd.h>
+    #include <poll.h>
+    #include <cerrno>
+#endif
+
+using namespace std;
+
+#ifdef _WIN32
+
+// Windows 控制台用 _getch() 读取时本来就不回显、不等回车，无需切换模式
+bool Terminal::enterRawMode() { return true; }
+void Terminal::leaveRawMode() {}
+bool Terminal::isRaw() { return true; }
+void Terminal::restore() {}
+
+#else
+
+// 信号处理函数要访问，只能放在文件作用域
+static struct termios savedTerminal;
+static volatile sig_atomic_t rawActive = 0;
+static int rawDepth = 0;
+static bool handlersInstalled = false;
+
+static void restoreOnSignal(int sig) {
+    Terminal::restore();
+    signal(sig, SIG_DFL);
+    raise(sig);  // 按默认方式终止，退出码与未处理时相同
+}
+
+static void installHandlers() {
+    if (handlersInstalled) {
+        return;
+    }
+    handlersInstalled = true;
+    atexit(Terminal::restore);
+
+    const int signals[] = {SIGINT, SIGTERM, SIGHUP, SIGQUIT};
+    for (int sig : signals) {
+        struct sigaction action = {};
+        action.sa_handler = restoreOnSignal;
+        sigemptyset(&action.sa_mask);
+        sigaction(sig, &action, nullptr);
+    }
+}
+
+bool Terminal::enterRawMode() {
+    if (rawDepth++ > 0) {
+        return rawActive != 0;
+    }
+    if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &savedTerminal) != 0) {
+        return false;
+    }
+    installHandlers();
+
+    struct termios raw = savedTerminal;
+    raw.c_lflag &= ~(ICANON | ECHO | IEXTEN);
+    raw.c_iflag &= ~IXON;  // Ctrl-S 不再冻结输出
+    raw.c_cc[VMIN] = 1;
+    raw.c_cc[VTIME] = 0;
+    if (tcsetattr(STDIN_FILENO, TCSANOW, &raw) != 0) {
+        return false;
+    }
+    rawActive = 1;
+    return true;
+}
+
+void Terminal::leaveRawMode() {
+    if (rawDepth > 0 && --rawDepth == 0) {
+        restore();
+    }
+}
+
+bool Terminal::isRaw() {
+    return rawActive != 0;
+}
+
+void Terminal::restore() {
+    if (!rawActive) {
+        return;
+    }
+    rawActive = 0;
+    tcsetattr(STDIN_FILENO, TCSANOW, &savedTerminal);
+
+    // 渲染器绘制期间会隐藏光标，被中断时要重新显示
+    static const char showCursor[] = "\033[?25h";
+    ssize_t written = write(STDOUT_FILENO, showCursor, sizeof(showCursor) - 1);
+    (void)written;
+}
+
+#endif
+
+KeyReader::KeyReader(int fd) : fd(fd), head(0), tail(0), closed(false), skipNewline(false) {}
+
+int KeyReader::fill() {
+    return readSome(false);
+}
+
+bool KeyReader::next(char& key) {
+    if (head == tail && readSome(false) <= 0) {
+        return false;
+    }
+    key = buffer[head++];
+    return true;
+}
+
+bool KeyReader::wait(char& key) {
+    while (head == tail) {
+        if (closed || readSome(true) < 0) {
+            return false;
+        }
+    }
+    key = buffer[head++];
+    return true;
+}
+
+bool KeyReader::readLine(string& line) {
+    line.clear();
+    char key;
+    bool any = false;
+    while (wait(key)) {
+        if (key == '\n' && skipNewline) {
+            skipNewline = false;
+            continue;
+        }
+        skipNewline = key == '\r';
+        if (key == '\r' || key == '\n') {
+#ifdef _WIN32
+            _putch('\r');
+            _putch('\n');
+#endif
+            return true;
+        }
+#ifdef _WIN32
+        _putch(key);
+#endif
+        line += key;
+        any = true;
+    }
+    return any;
+}
+
+#ifdef _WIN32
+
+int KeyReader::readSome(bool block) {
+    if (head == tail) {
+        head = tail = 0;
+    }
+    int count = 0;
+    if (block && tail < BUFFER_SIZE) {
+        buffer[tail++] = static_cast<char>(_getch());
+        count++;
+    }
+    while (tail < BUFFER_SIZE && _kbhit()) {
+        buffer[tail++] = static_cast<char>(_getch());
+        count++;
+    }
+    return count;
+}
+
+#else
+
+int KeyReader::readSome(bool block) {
+    if (closed) {
+        return -1;
+    }
+    // 缓冲取空后从头开始，未取走的字节移到开头
+    if (head == tail) {
+        head = tail = 0;
+    } else if (tail == BUFFER_SIZE && head > 0) {
+        for (int i = head; i < tail; i++) {
+            buffer[i - head] = buffer[i];
+        }
+        tail -= head;
+        head = 0;
+    }
+    if (tail == BUFFER_SIZE) {
+        return 0;
+    }
+
+    // 先用 poll 确认有数据再读，不改动文件描述符的阻塞标志：wait()/readLine() 靠 poll 阻塞等待
+    struct pollfd pfd = {fd, POLLIN, 0};
+    int ready = poll(&pfd, 1, block ? -1 : 0);
+    if (ready < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    if (ready == 0) {
+        return 0;
+    }
+
+    ssize_t n = read(fd, buffer + tail, BUFFER_SIZE - tail);
+    if (n > 0) {
+        tail += static_cast<int>(n);
+        return static_cast<int>(n);
+    }
+    if (n == 0 || (errno != EINTR && errno != EAGAIN)) {
+        closed = true;
+        return -1;
+    }
+    return 0;
+}
+
+#endif
@@ -0,0 +1,72 @@
+// Terminal.h
+#ifndef TERMINAL_H
+#define TERMINAL_H
+
+#include <string>
+
+// 终端原始模式
+// 进入时只调用一次 tcgetattr/tcsetattr：关闭行缓冲、回显和流控，每个按键立即可读；
+// 保留信号键（Ctrl-C 仍产生 SIGINT）和输出处理。
+// 第一次进入时注册 atexit 和 SIGINT/SIGTERM/SIGHUP/SIGQUIT 处理函数，
+// 程序退出或被信号终止时恢复原来的终端设置并重新显示光标。
+// 可以嵌套进入，只有最外层的 leave() 才真正恢复。标准输入不是终端时什么也不做。
+class Terminal {
+public:
+    static bool enterRawMode();
+    static void leaveRawMode();
+    static bool isRaw();
+
+    // 立即恢复终端设置（异步信号安全，可重复调用）
+    static void restore();
+
+    // 作用域内保持原始模式
+    class RawMode {
+    public:
+        RawMode() { Terminal::enterRawMode(); }
+        ~RawMode() { Terminal::leaveRawMode(); }
+        RawMode(const RawMode&) = delete;
+        RawMode& operator=(const RawMode&) = delete;
+    };
+};
+
+// 带缓冲的按键读取
+// fill() 一次 read() 取走已经到达的全部字节（不阻塞），之后 next() 直接从缓冲中取，
+// 快速连按或管道输入时每个时钟周期只需一次系统调用，也不会丢键。
+// 直接读文件描述符，不经过 stdio 的缓冲；菜单的整行输入也通过它读取（readLine），
+// 管道输入时菜单和对局看到的是同一个字节流，不会有字节被另一个缓冲截走。
+class KeyReader {
+public:
+    static constexpr int BUFFER_SIZE = 4096;
+
+private:
+    int fd;
+    char buffer[BUFFER_SIZE];
+    int head, tail;  // 未取走的字节为 [head, tail)
+    bool closed;     // 读到文件末尾或出错
+    bool skipNewline;  // 上一行以 '\r' 结束，紧跟的 '\n' 属于同一个换行
+
+public:
+    explicit KeyReader(int fd = 0);
+
+    // 读出当前已到达的字节（不阻塞），返回读到的字节数
+    int fill();
+
+    // 取下一个按键；缓冲为空时先不阻塞地读取一次，仍没有按键时返回 false
+    bool next(char& key);
+
+    // 阻塞直到有按键，输入关闭时返回 false
+    bool wait(char& key);
+
+    // 阻塞读取一行（不含换行符，兼容 "\r\n" 和 "\r"），输入关闭且没有读到内容时返回 false
+    // 终端处于规范模式时由终端负责回显和行编辑；Windows 控制台上自行回显
+    bool readLine(std::string& line);
+
+    bool isClosed() const { return closed && head == tail; }
+    int pending() const { return tail - head; }
+    int getFd() const { return fd; }
+
+private:
+    int readSome(bool block);
+};
+
+#endif
@@ -0,0 +1,310 @@
+// Benchmark.cpp
+// 迷宫引擎热点路径的基准测试
+//
+// 编译（在仓库根目录）：
+//   g++ -std=c++17 -O2 -pthread -I. bench/Benchmark.cpp $(ls *.cpp | grep -v main.cpp) -o maze_bench
+// 用法：
+//   maze_bench [--reps N] [--warmup N] [--max-size N] [--budget 毫秒] [--filter 子串] [--seed S] [--csv]
+// 默认输出 JSON，--csv 输出 CSV；每项给出耗时分位数、每次操作的堆分配次数和扩展节点数等计数。
+#include "Map.h"
+#include "MazeGenerator.h"
+#include "PathFinder.h"
+#include "FogOfWar.h"
+#include "FrameRenderer.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+using namespace std;
+using namespace std::chrono;
+
+// 堆分配计数：替换全局 operator new，只统计次数
+static atomic<uint64_t> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) throw bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct BenchOptions {
+    int reps;
+    int warmup;
+    int maxSize;
+    double budgetMs;    // 单项的时间预算，超出后停止重复（至少重复 3 次）
+    string filter;
+    uint64_t seed;
+    bool csv;
+    
+    BenchOptions() : reps(50), warmup(3), maxSize(4096), budgetMs(2000), seed(1), csv(false) {}
+};
+
+struct BenchResult {
+    string name;
+    string mapName;
+    int width, height;
+    int reps;
+    double minNs, meanNs, p50Ns, p90Ns, p99Ns;
+    double allocsPerOp;
+    double counterPerOp;   // 各项自己的计数（扩展节点数、输出字节数等）
+    string counterName;
+};
+
+static double percentile(const vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0;
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[min(index, sorted.size() - 1)];
+}
+
+// 运行一项基准：op 执行一次操作并返回该次的计数
+static bool runBench(const BenchOptions& options, const string& name, const Map& map,
+                     const string& counterName, const function<long long()>& op,
+                     vector<BenchResult>& results) {
+    if (!options.filter.empty() && name.find(options.filter) == string::npos) {
+        return false;
+    }
+    
+    for (int i = 0; i < options.warmup; i++) {
+        op();
+    }
+    
+    vector<double> samples;
+    uint64_t allocations = 0;
+    long long counter = 0;
+    auto benchStart = steady_clock::now();
+    for (int i = 0; i < options.reps; i++) {
+        uint64_t allocBefore = allocationCount.load(memory_order_relaxed);
+        auto t0 = steady_clock::now();
+        counter += op();
+        auto t1 = steady_clock::now();
+        allocations += allocationCount.load(memory_order_relaxed) - allocBefore;
+        samples.push_back(duration<double, nano>(t1 - t0).count());
+        
+        if (i >= 2 && duration<double, milli>(t1 - benchStart).count() > options.budgetMs) {
+            break;
+        }
+    }
+    
+    BenchResult result;
+    result.name = name;
+    result.mapName = map.getName();
+    result.width = map.getWidth();
+    result.height = map.getHeight();
+    result.reps = static_cast<int>(samples.size());
+    double total = 0;
+    for (double s : samples) total += s;
+    sort(samples.begin(), samples.end());
+    result.minNs = samples.front();
+    result.meanNs = total / samples.size();
+    result.p50Ns = percentile(samples, 0.50);
+    result.p90Ns = percentile(samples, 0.90);
+    result.p99Ns = percentile(samples, 0.99);
+    result.allocsPerOp = static_cast<double>(allocations) / samples.size();
+    result.counterPerOp = static_cast<double>(counter) / samples.size();
+    result.counterName = counterName;
+    results.push_back(result);
+    
+    cerr << "  " << left << setw(28) << name << " " << setw(12) << map.getName()
+         << " p50 " << fixed << setprecision(1) << result.p50Ns / 1000.0 << " us\n";
+    return true;
+}
+
+// 组装一帧：以 center 为中心的视口（最多 200x80 格），与游戏画面的绘制方式相同
+static long long composeFrame(FrameRenderer& frame, const Map& map, const Position& center,
+                              const FogOfWar& fog, string& rowText) {
+    const int viewW = min(map.getWidth(), 200);
+    const int viewH = min(map.getHeight(), 80);
+    int x0 = max(0, min(center.x - viewW / 2, map.getWidth() - viewW));
+    int y0 = max(0, min(center.y - viewH / 2, map.getHeight() - viewH));
+    
+    frame.beginFrame(max(viewW * 2, 100));
+    frame.line("=== " + map.getName() + " ===");
+    frame.line("生命值: 100/100 (100%)");
+    frame.line("");
+    for (int y = y0; y < y0 + viewH; y++) {
+        const uint8_t* cells = map.row(y);
+        rowText.clear();
+        for (int x = x0; x < x0 + viewW; x++) {
+            if (x == center.x && y == center.y) {
+                rowText += "P ";
+                continue;
+            }
+            if (fog.getFogState(x, y) == FOG_UNEXPLORED) {
+                rowText += "? ";
+                continue;
+            }
+            switch (static_cast<CellType>(cells[x])) {
+                case WALL: rowText += "# "; break;
+                case TRAP: rowText += "x "; break;
+                case START: rowText += "S "; break;
+                case END: rowText += "E "; break;
+                default: rowText += "  "; break;
+            }
+        }
+        frame.line(rowText);
+    }
+    frame.line("使用 WASD 移动 (Q退出): ");
+    return static_cast<long long>(frame.composeDiff().size());
+}
+
+static void benchMap(const BenchOptions& options, const Map& map, vector<BenchResult>& results) {
+    Position start = map.getStartPosition();
+    Position end = map.getEndPosition();
+    
+    // 寻路
+    const struct { const char* name; SearchMode mode; } modes[] = {
+        {"findPath/astar", SEARCH_ASTAR},
+        {"findPath/jps", SEARCH_JPS},
+        {"findPath/weighted", SEARCH_WEIGHTED},
+        {"findPath/hierarchical", SEARCH_HIERARCHICAL},
+        {"findPath/alt", SEARCH_ALT},
+        {"findPath/corridor", SEARCH_CORRIDOR},
+    };
+    vector<Position> path;
+    for (const auto& m : modes) {
+        PathFinder finder(&map);
+        finder.setSearchMode(m.mode);
+        if (m.mode == SEARCH_WEIGHTED) {
+            finder.setTrapCost(10);
+            finder.setHealthBudget(100, 30);
+        }
+        runBench(options, m.name, map, "expanded", [&]() {
+            finder.findPath(start, end, path);
+            return static_cast<long long>(finder.getLastExpandedCount());
+        }, results);
+    }
+    
+    // 地标距离表的构建（各地标的 BFS 并行）
+    Landmarks landmarks;
+    runBench(options, "landmarks/build", map, "landmarks", [&]() {
+        landmarks.build(map);
+        return static_cast<long long>(landmarks.getCount());
+    }, results);
+    
+    runBench(options, "hasValidPath", map, "found", [&]() {
+        return static_cast<long long>(map.hasValidPath());
+    }, results);
+    
+    // 迷雾和渲染沿一条实际路径移动；无路时在起点附近原地更新
+    PathFinder finder(&map);
+    vector<Position> walk;
+    if (!finder.findPath(start, end, walk)) {
+        walk.assign(1, start);
+    }
+    
+    const struct { const char* name; VisionMode mode; } visions[] = {
+        {"fog/update_radius8", VISION_RADIUS},
+        {"fog/update_shadowcast8", VISION_SHADOWCAST},
+    };
+    for (const auto& v : visions) {
+        FogOfWar fog(map.getWidth(), map.getHeight(), 8);
+        fog.setVisionMode(v.mode, &map);
+        size_t step = 0;
+        runBench(options, v.name, map, "steps", [&]() {
+            fog.updateVisibility(walk[step++ % walk.size()]);
+            return 1LL;
+        }, results);
+    }
+    
+    FogOfWar fog(map.getWidth(), map.getHeight(), 8);
+    for (const Position& p : walk) {
+        fog.updateVisibility(p);
+    }
+    volatile float sink = 0;
+    runBench(options, "fog/exploredPercent", map, "calls", [&]() {
+        sink = sink + fog.getExploredPercent();
+        return 1LL;
+    }, results);
+    
+    // 完整一帧：组装画面并生成差量输出（不写终端）
+    FrameRenderer frame;
+    string rowText;
+    size_t step = 0;
+    runBench(options, "render/frame", map, "bytes", [&]() {
+        return composeFrame(frame, map, walk[step++ % walk.size()], fog, rowText);
+    }, results);
+}
+
+static string jsonEscape(const string& text) {
+    string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+static void printResults(const BenchOptions& options, const vector<BenchResult>& results) {
+    cout << fixed << setprecision(1);
+    if (options.csv) {
+        cout << "name,map,width,height,reps,min_ns,mean_ns,p50_ns,p90_ns,p99_ns,allocs_per_op,counter,counter_per_op\n";
+        for (const BenchResult& r : results) {
+            cout << r.name << "," << r.mapName << "," << r.width << "," << r.height << "," << r.reps << ","
+                 << r.minNs << "," << r.meanNs << "," << r.p50Ns << "," << r.p90Ns << "," << r.p99Ns << ","
+                 << r.allocsPerOp << "," << r.counterName << "," << r.counterPerOp << "\n";
+        }
+        return;
+    }
+    
+    cout << "{\n  \"seed\": " << options.seed << ",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        cout << "    {\"name\": \"" << jsonEscape(r.name) << "\", \"map\": \"" << jsonEscape(r.mapName)
+             << "\", \"width\": " << r.width << ", \"height\": " << r.height << ", \"reps\": " << r.reps
+             << ", \"min_ns\": " << r.minNs << ", \"mean_ns\": " << r.meanNs
+             << ", \"p50_ns\": " << r.p50Ns << ", \"p90_ns\": " << r.p90Ns << ", \"p99_ns\": " << r.p99Ns
+             << ", \"allocs_per_op\": " << r.allocsPerOp
+             << ", \"" << r.counterName << "_per_op\": " << r.counterPerOp << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    cout << "  ]\n}\n";
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--reps") == 0 && hasValue) options.reps = max(1, atoi(argv[++i]));
+        else if (strcmp(arg, "--warmup") == 0 && hasValue) options.warmup = max(0, atoi(argv[++i]));
+        else if (strcmp(arg, "--max-size") == 0 && hasValue) options.maxSize = atoi(argv[++i]);
+        else if (strcmp(arg, "--budget") == 0 && hasValue) options.budgetMs = atof(argv[++i]);
+        else if (strcmp(arg, "--filter") == 0 && hasValue) options.filter = argv[++i];
+        else if (strcmp(arg, "--seed") == 0 && hasValue) options.seed = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(arg, "--csv") == 0) options.csv = true;
+        else {
+            cerr << "未知参数: " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    vector<BenchResult> results;
+    
+    // 预设地图
+    benchMap(options, Map::createMap1(), results);
+    benchMap(options, Map::createMap2(), results);
+    
+    // 合成地图：Eller 迷宫，带少量环路和陷阱
+    for (int size = 64; size <= options.maxSize; size *= 4) {
+        MazeOptions maze(size - 1, size - 1, MAZE_ELLER, options.seed);
+        maze.braidDensity = 0.25;
+        maze.trapDensity = 0.002;
+        maze.name = "maze" + to_string(size);
+        benchMap(options, Map::createRandomMap(maze), results);
+    }
+    
+    printResults(options, results);
+    return 0;
+}
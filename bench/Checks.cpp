@@ -0,0 +1,166 @@
+// bench/Checks.cpp
+// 回归检查 maze_checks：不需要终端，覆盖文件格式的校验和手动移动的规则，逐项运行，全部通过返回 0，否则打印失败项并返回 1
+// 构建：g++ -std=c++17 -O2 -pthread -I. bench/Checks.cpp $(ls *.cpp | grep -v '^main.cpp$') -o maze_checks
+#include "Map.h"
+#include "MapFile.h"
+#include "PagedMap.h"
+#include "Landmarks.h"
+#include "PathFinder.h"
+#include "AnytimePlanner.h"
+#include "GameSession.h"
+#include "Simulator.h"
+#include "Terminal.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& name) {
+    cout << (ok ? "[通过] " : "[失败] ") << name << "\n";
+    if (!ok) {
+        failures++;
+    }
+}
+
+// 改写文件中 offset 处的 8 字节（小端，与文件格式一致）
+static bool patchUint64(const string& path, long offset, uint64_t value) {
+    fstream file(path, ios::in | ios::out | ios::binary);
+    if (!file) return false;
+    file.seekp(offset);
+    file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    return static_cast<bool>(file);
+}
+
+// 地图文件头的 cellOffset + cellBytes 回绕到文件大小以内时必须拒绝，不能越界读取
+static void checkCorruptMapHeader() {
+    const string path = "maze_checks_corrupt.map";
+    Map map = Map::createMap1();
+    check(MapFile::save(map, path), "保存地图文件");
+
+    Map loaded(1, 1, "");
+    check(MapFile::open(path, loaded), "读取完整的地图文件");
+
+    // 文件头布局：cellOffset 位于第 48 字节，cellBytes 位于第 56 字节
+    uint64_t cellBytes = static_cast<uint64_t>(map.getWidth() + 2) * (map.getHeight() + 2);
+    uint64_t wrappedOffset = UINT64_MAX - cellBytes + 1 + 64;  // 与 cellBytes 相加回绕为 64
+    check(patchUint64(path, 48, wrappedOffset), "改写 cellOffset");
+    check(!MapFile::open(path, loaded), "拒绝 cellOffset 回绕的地图文件");
+
+    PagedMap paged;
+    check(!paged.open(path), "分页地图拒绝 cellOffset 回绕的地图文件");
+
+    remove(path.c_str());
+}
+
+// 地标表的 tableOffset + tableBytes 回绕时必须拒绝，否则启发值读到映射之外
+static void checkCorruptLandmarkHeader() {
+    const string path = "maze_checks_corrupt.alt";
+    Map map = Map::createMap2();
+    Landmarks landmarks;
+    landmarks.build(map, 4, 1);
+    check(landmarks.save(path), "保存地标表");
+
+    Landmarks loaded;
+    check(loaded.load(path, map), "读取完整的地标表");
+
+    // 文件头布局：tableOffset 位于第 40 字节；偏移须按 64 字节对齐，和 tableBytes 相加回绕到 128 以内
+    uint64_t tableBytes = static_cast<uint64_t>(landmarks.getCount()) * map.getCellCount() * sizeof(uint32_t);
+    uint64_t wrappedOffset = (UINT64_MAX - tableBytes + 1 + 128) & ~static_cast<uint64_t>(63);
+    check(patchUint64(path, 40, wrappedOffset), "改写 tableOffset");
+    check(!loaded.load(path, map), "拒绝 tableOffset 回绕的地标表");
+
+    remove(path.c_str());
+}
+
+// createMap1 上一条固定的通关按键序列：57 步，途中踩中 3 个陷阱
+static const char WIN_KEYS[] = "sssssssddwwwwwwwddssssssddwwwwwddssssssddwwwwwwwddsssssss";
+
+static bool samePosition(const Position& a, const Position& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+// 手动移动的规则：撞墙不移动、不计步，陷阱扣血，到达终点即胜利
+static void checkScriptedSession() {
+    Map map = Map::createMap1();
+    GameSession session(map, false, false);
+
+    // 先走到左下角，再多按一次撞上墙
+    for (int i = 0; i < 8; i++) {
+        session.applyMove('s');
+    }
+    const Player& player = session.getPlayer();
+    check(samePosition(player.getPosition(), Position(1, 8)) && player.getSteps() == 7 &&
+          player.getHealth() == 100 && !session.isOver(), "撞墙不移动也不计步");
+
+    GameSession winner(map, false, false);
+    for (const char* key = WIN_KEYS; *key != '\0'; key++) {
+        winner.applyMove(*key);
+    }
+    const Player& end = winner.getPlayer();
+    check(winner.getStatus() == GAME_WON && samePosition(end.getPosition(), map.getEndPosition()),
+          "按键脚本到达终点并获胜");
+    check(end.getSteps() == 57, "按键脚本的步数");
+    check(end.getHealth() == 100 - 3 * GameSession::TRAP_DAMAGE, "按键脚本踩中陷阱后的生命值");
+}
+
+// 无界面回放：与 main --headless --script 相同的路径，按键从文件描述符读取
+static void checkScriptedReplay() {
+    FILE* script = tmpfile();
+    if (script == nullptr) {
+        check(false, "创建按键脚本文件");
+        return;
+    }
+    fputs(WIN_KEYS, script);
+    fputs("\nq", script);
+    fflush(script);
+    rewind(script);
+
+    KeyReader input(fileno(script));
+    long long keyCount = 0;
+    SimulationStats stats = Simulator::replay(Map::createMap1(), SimulationOptions(), input, keyCount);
+    check(stats.wins == 1 && stats.losses == 0 && stats.timeouts == 0, "回放按键脚本获胜");
+    check(stats.steps == 57, "回放的步数");
+    check(keyCount == 57, "胜利后不再读取剩余按键");
+    fclose(script);
+}
+
+// 起点即终点时 ARA* 与带权搜索一样给出单格路径，而不是报告不可达
+static void checkAnytimeStartIsGoal() {
+    Map map = Map::createMap1();
+    Position start = map.getStartPosition();
+
+    PathFinder finder(&map);
+    finder.setSearchMode(SEARCH_WEIGHTED);
+    vector<Position> weighted;
+    check(finder.findPath(start, start, weighted) && weighted.size() == 1, "带权搜索：起点即终点");
+
+    AnytimePlanner planner(&map);
+    vector<Position> path;
+    int cost = -1;
+    double epsilon = 0;
+    bool found = planner.plan(start, start, [&](const vector<Position>& p, int c, double e) {
+        path = p;
+        cost = c;
+        epsilon = e;
+    });
+    check(found && path.size() == 1 && samePosition(path[0], start) && cost == 0 && epsilon == 1.0,
+          "ARA*：起点即终点发布单格路径");
+}
+
+int main() {
+    checkCorruptMapHeader();
+    checkCorruptLandmarkHeader();
+    checkScriptedSession();
+    checkScriptedReplay();
+    checkAnytimeStartIsGoal();
+
+    cout << (failures == 0 ? "全部通过\n" : "存在失败项\n");
+    return failures == 0 ? 0 : 1;
+}
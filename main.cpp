@@ -1,7 +1,134 @@
 #include "Game.h"
+#include "Simulator.h"
+#include "MazeGenerator.h"
+#include "MapFile.h"
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
 
-int main() {
+using namespace std;
+
+// 无界面模式：main --headless [对局数] [--map 序号] [--manual] [--fog] [--los] [--seed S] [--max-steps N]
+//             随机地图：[--size 宽x高] [--algo backtracker|wilson|eller] [--braid p] [--traps p]
+//             地图文件：[--load 文件] 读取二进制或 .txt 文本地图，[--save 文件] 保存本次使用的地图
+//             回放脚本：[--script] 从标准输入读取 WASD 按键序列，全速回放一局
+//                       例如 echo "ddddssss" | main --headless --script
+static int runHeadless(int argc, char* argv[]) {
+    SimulationOptions options;
+    int mapIndex = 1;
+    bool randomMap = false;
+    MazeOptions maze;
+    string loadPath, savePath;
+    bool scripted = false;
+    
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "--headless") == 0) {
+            if (hasValue && argv[i + 1][0] != '-') {
+                options.games = atoi(argv[++i]);
+            }
+        } else if (strcmp(arg, "--map") == 0 && hasValue) {
+            mapIndex = atoi(argv[++i]);
+        } else if (strcmp(arg, "--auto") == 0) {
+            options.autoMode = true;
+        } else if (strcmp(arg, "--manual") == 0) {
+            options.autoMode = false;
+        } else if (strcmp(arg, "--script") == 0) {
+            scripted = true;
+        } else if (strcmp(arg, "--fog") == 0) {
+            options.fogMode = true;
+        } else if (strcmp(arg, "--los") == 0) {
+            options.fogMode = true;
+            options.visionMode = VISION_SHADOWCAST;
+        } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+            options.seed = static_cast<unsigned>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(arg, "--max-steps") == 0 && hasValue) {
+            options.maxSteps = atoi(argv[++i]);
+        } else if (strcmp(arg, "--load") == 0 && hasValue) {
+            loadPath = argv[++i];
+        } else if (strcmp(arg, "--save") == 0 && hasValue) {
+            savePath = argv[++i];
+        } else if (strcmp(arg, "--size") == 0 && hasValue) {
+            if (sscanf(argv[++i], "%dx%d", &maze.width, &maze.height) != 2) {
+                cerr << "地图尺寸格式应为 宽x高\n";
+                return 1;
+            }
+            randomMap = true;
+        } else if (strcmp(arg, "--algo") == 0 && hasValue) {
+            if (!MazeGenerator::parseAlgorithm(argv[++i], maze.algorithm)) {
+                cerr << "未知的迷宫算法: " << argv[i] << "\n";
+                return 1;
+            }
+            randomMap = true;
+        } else if (strcmp(arg, "--braid") == 0 && hasValue) {
+            maze.braidDensity = atof(argv[++i]);
+            randomMap = true;
+        } else if (strcmp(arg, "--traps") == 0 && hasValue) {
+            maze.trapDensity = atof(argv[++i]);
+            randomMap = true;
+        } else {
+            cerr << "未知参数: " << arg << "\n";
+            return 1;
+        }
+    }
+    
+    Map map = mapIndex == 2 ? Map::createMap2() : Map::createMap1();
+    if (randomMap) {
+        maze.seed = options.seed;
+        map = Map::createRandomMap(maze);
+    }
+    if (!loadPath.empty()) {
+        bool isText = loadPath.size() > 4 && loadPath.compare(loadPath.size() - 4, 4, ".txt") == 0;
+        if (!(isText ? MapFile::importText(loadPath, map) : MapFile::open(loadPath, map))) {
+            cerr << "无法读取地图文件: " << loadPath << "\n";
+            return 1;
+        }
+    }
+    if (!savePath.empty()) {
+        bool isText = savePath.size() > 4 && savePath.compare(savePath.size() - 4, 4, ".txt") == 0;
+        if (!(isText ? MapFile::exportText(map, savePath) : MapFile::save(map, savePath))) {
+            cerr << "无法保存地图文件: " << savePath << "\n";
+            return 1;
+        }
+    }
+    
+    long long keyCount = 0;
+    SimulationStats stats;
+    if (scripted) {
+        KeyReader input;
+        options.games = 1;
+        stats = Simulator::replay(map, options, input, keyCount);
+    } else {
+        stats = Simulator::run(map, options);
+    }
+    
+    cout << "地图: " << map.getName() << "\n";
+    cout << "对局: " << options.games
+         << "  胜: " << stats.wins
+         << "  负: " << stats.losses
+         << "  超时: " << stats.timeouts << "\n";
+    cout << "总步数: " << stats.steps << "\n";
+    cout << "耗时: " << stats.elapsedMs << " ms";
+    if (options.games > 0) {
+        cout << " (" << stats.elapsedMs / options.games << " ms/局)";
+    }
+    cout << "\n";
+    if (scripted) {
+        cout << "按键: " << keyCount << "\n";
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            return runHeadless(argc, argv);
+        }
+    }
+    
     Game game;
     game.run();
     return 0;
-}
\ No newline at end of file
+}
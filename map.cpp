@@ -1,19 +1,60 @@
 // Map.cpp
-#include "map.h"
+#include "Map.h"
+#include "Reachability.h"
+#include "MazeGenerator.h"
 #include <iostream>
 #include <random>
-#include <queue>
+#include <algorithm>
 
 using namespace std;
 
 Map::Map(int w, int h, const string& name) 
-    : width(w), height(h), mapName(name) {
-    grid.resize(height, vector<int>(width, EMPTY));
+    : width(w), height(h), stride(w + 2), mapName(name), mappedCells(nullptr),
+      componentsValid(false), revision(0) {
+    // 整块填充为墙壁，再把内部区域清空，边框自然成为哨兵
+    cells.assign(static_cast<size_t>(stride) * (height + 2), WALL);
+    for (int y = 0; y < height; y++) {
+        uint8_t* rowPtr = cells.data() + cellIndex(0, y);
+        fill(rowPtr, rowPtr + width, static_cast<uint8_t>(EMPTY));
+    }
 }
 
 void Map::setCell(int x, int y, CellType type) {
     if (isValidPosition(x, y)) {
-        grid[y][x] = type;
+        detach();
+        int index = cellIndex(x, y);
+        CellType oldType = static_cast<CellType>(cells[index]);
+        bool wasOpen = oldType != WALL;
+        bool isOpen = type != WALL;
+        cells[index] = static_cast<uint8_t>(type);
+        
+        // 记录修改，日志过长时丢弃较早的一半
+        if (oldType != type) {
+            if (changeLog.size() >= MAX_CHANGE_LOG) {
+                changeLog.erase(changeLog.begin(), changeLog.begin() + MAX_CHANGE_LOG / 2);
+            }
+            changeLog.push_back({x, y, oldType, type});
+            revision++;
+        }
+        
+        // 维护连通分量索引
+        if (componentsValid && wasOpen != isOpen) {
+            if (isOpen) {
+                // 打通一个格子：与四周可通行的分量合并
+                componentParent[index] = index;
+                const int offsets[] = {-stride, 1, stride, -1};
+                for (int i = 0; i < 4; i++) {
+                    int neighbor = index + offsets[i];
+                    if (cells[neighbor] != WALL) {
+                        uniteComponents(index, neighbor);
+                    }
+                }
+            } else {
+                // 砌墙可能把分量一分为二，下次查询时重新标记
+                componentsValid = false;
+            }
+        }
+        
         if (type == START) {
             startPos = Position(x, y);
         } else if (type == END) {
@@ -24,55 +65,143 @@ void Map::setCell(int x, int y, CellType type) {
 
 CellType Map::getCell(int x, int y) const {
     if (isValidPosition(x, y)) {
-        return static_cast<CellType>(grid[y][x]);
+        return static_cast<CellType>(data()[cellIndex(x, y)]);
     }
     return WALL;  // 无效位置视为墙壁
 }
 
+void Map::detach() {
+    if (mappedCells == nullptr) return;
+    cells.assign(mappedCells, mappedCells + getCellCount());
+    mappedCells = nullptr;
+    mapping.reset();
+}
+
+Map Map::snapshot() const {
+    Map copy(1, 1, mapName);
+    copy.width = width;
+    copy.height = height;
+    copy.stride = stride;
+    copy.startPos = startPos;
+    copy.endPos = endPos;
+    copy.revision = revision;
+    copy.cells.clear();
+    copy.cells.shrink_to_fit();
+    
+    if (mappedCells) {
+        copy.mappedCells = mappedCells;
+        copy.mapping = mapping;
+    } else {
+        auto buffer = make_shared<vector<uint8_t>>(cells);
+        copy.mappedCells = buffer->data();
+        copy.mapping = shared_ptr<const void>(buffer, buffer->data());
+    }
+    return copy;
+}
+
 bool Map::isValidPosition(int x, int y) const {
     return x >= 0 && x < width && y >= 0 && y < height;
 }
 
 bool Map::hasValidPath() const {
-    // 使用BFS检查路径是否存在
-    vector<vector<bool>> visited(height, vector<bool>(width, false));
-    queue<Position> q;
-    
-    q.push(startPos);
-    visited[startPos.y][startPos.x] = true;
-    
-    int dx[] = {0, 1, 0, -1};
-    int dy[] = {-1, 0, 1, 0};
+    // 使用位并行的洪水填充检查路径是否存在
+    if (!isValidPosition(startPos.x, startPos.y) || !isValidPosition(endPos.x, endPos.y)) {
+        return false;
+    }
     
-    while (!q.empty()) {
-        Position current = q.front();
-        q.pop();
-        
-        if (current == endPos) {
-            return true;
-        }
-        
-        for (int i = 0; i < 4; i++) {
-            int nx = current.x + dx[i];
-            int ny = current.y + dy[i];
-            
-            if (isValidPosition(nx, ny) && !visited[ny][nx] && 
-                getCell(nx, ny) != WALL) {
-                visited[ny][nx] = true;
-                q.push(Position(nx, ny));
+    return Reachability::floodFill(*this, startPos, endPos);
+}
+
+bool Map::getChangesSince(uint64_t since, vector<CellChange>& changes) const {
+    changes.clear();
+    if (since > revision) {
+        return false;
+    }
+    uint64_t count = revision - since;
+    if (count > changeLog.size()) {
+        return false;  // 所需的记录已被丢弃
+    }
+    changes.assign(changeLog.end() - count, changeLog.end());
+    return true;
+}
+
+bool Map::isReachable(const Position& from, const Position& to) const {
+    int a = getComponent(from.x, from.y);
+    return a != -1 && a == getComponent(to.x, to.y);
+}
+
+int Map::getComponent(int x, int y) const {
+    if (!isValidPosition(x, y)) {
+        return -1;
+    }
+    if (!componentsValid) {
+        buildComponents();
+    }
+    int index = cellIndex(x, y);
+    return data()[index] == WALL ? -1 : findComponent(index);
+}
+
+void Map::buildComponents() const {
+    // 逐行扫描，每个可通行格子与左侧、上方的可通行格子合并
+    const uint8_t* cellData = data();
+    componentParent.assign(getCellCount(), -1);
+    for (int y = 0; y < height; y++) {
+        int index = cellIndex(0, y);
+        for (int x = 0; x < width; x++, index++) {
+            if (cellData[index] == WALL) {
+                continue;
+            }
+            componentParent[index] = index;
+            if (cellData[index - 1] != WALL) {
+                uniteComponents(index, index - 1);
+            }
+            if (cellData[index - stride] != WALL) {
+                uniteComponents(index, index - stride);
             }
         }
     }
     
-    return false;
+    // 完全压缩：每个格子直接指向代表元，之后的查询只读不写
+    for (size_t i = 0; i < componentParent.size(); i++) {
+        if (componentParent[i] != -1) {
+            componentParent[i] = findComponent(static_cast<int>(i));
+        }
+    }
+    componentsValid = true;
+}
+
+int Map::findComponent(int index) const {
+    // 路径减半；已压缩时不产生写操作
+    while (componentParent[index] != index) {
+        int grandParent = componentParent[componentParent[index]];
+        if (componentParent[index] != grandParent) {
+            componentParent[index] = grandParent;
+        }
+        index = grandParent;
+    }
+    return index;
+}
+
+void Map::uniteComponents(int a, int b) const {
+    int rootA = findComponent(a);
+    int rootB = findComponent(b);
+    if (rootA != rootB) {
+        // 下标小的作为代表元，保证结果与合并顺序无关
+        if (rootA < rootB) {
+            componentParent[rootB] = rootA;
+        } else {
+            componentParent[rootA] = rootB;
+        }
+    }
 }
 
 void Map::display() const {
     cout << "=== " << mapName << " === (" << width << "x" << height << ")\n";
     
     for (int y = 0; y < height; y++) {
+        const uint8_t* rowCells = row(y);
         for (int x = 0; x < width; x++) {
-            CellType cell = getCell(x, y);
+            CellType cell = static_cast<CellType>(rowCells[x]);
             switch (cell) {
                 case EMPTY: cout << " "; break;
                 case WALL: cout << "#"; break;
@@ -170,4 +299,8 @@ Map Map::createMap2() {
     map.setCell(13, 1, END);
     
     return map;
-}
\ No newline at end of file
+}
+
+Map Map::createRandomMap(const MazeOptions& options) {
+    return MazeGenerator::generate(options);
+}
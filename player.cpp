@@ -1,6 +1,6 @@
 // Player.cpp
-#include "player.h"
-#include "map.h"
+#include "Player.h"
+#include "Map.h"
 #include <iostream>
 
 using namespace std;